@@ -0,0 +1,386 @@
+#include "../include/dpll_solver.h"
+#include "../include/cnf_parser.h"
+#include "../include/hanidoku_engine.h"
+#include "instances.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 基准测试: 在各实例族的一组规模上运行各求解算法, 每个实例重复多次
+// 输出每个(族, 规模, 算法)的时间中位数与 p95、每秒决策数与传播数, 格式为 CSV 或 JSON, 便于跟踪性能回归
+// 用法: bench [--engines basic,opt1,opt2,cdcl,native] [--families ...] [--instances N] [--repeat R]
+//             [--timeout 秒] [--seed S] [--quick] [--preprocess] [--csv 文件] [--json 文件]
+
+// 超时后置位取消标志
+class Watchdog
+{
+public:
+    Watchdog(std::atomic<bool> &cancel, double seconds)
+    {
+        if (seconds <= 0)
+            return;
+
+        thread = std::thread([this, &cancel, seconds]()
+                             {
+                                 std::unique_lock<std::mutex> lock(mtx);
+
+                                 if (!cv.wait_for(lock, std::chrono::duration<double>(seconds), [this]() { return done; }))
+                                     cancel = true; });
+    }
+
+    ~Watchdog()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done = true;
+        }
+
+        cv.notify_all();
+
+        if (thread.joinable())
+            thread.join();
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool done = false;
+    std::thread thread;
+};
+
+// 单次运行的结果, status 为 10 有解、20 无解、0 超时; valid 为解是否满足原公式
+struct RunResult
+{
+    double seconds;
+    long long decisions;
+    long long propagations;
+    int status;
+    bool valid;
+};
+
+// 一组(族, 规模, 算法)的统计
+struct BenchRow
+{
+    std::string family;
+    int size;
+    std::string engine;
+    std::vector<double> times;
+    long long decisions = 0;
+    long long propagations = 0;
+    double total_seconds = 0;
+    int sat = 0;
+    int unsat = 0;
+    int timeouts = 0;
+};
+
+struct BenchOptions
+{
+    std::vector<std::string> engines = {"basic", "opt1", "opt2", "cdcl", "native"};
+    std::vector<std::string> families = BenchInstances::Families();
+    int instances = 3;
+    int repeat = 3;
+    double timeout = 10;
+    unsigned seed = 1;
+    bool quick = false;
+    bool preprocessing = false;
+    std::string csv;
+    std::string json;
+};
+
+std::vector<std::string> split(const std::string &text)
+{
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+            items.push_back(item);
+    }
+
+    return items;
+}
+
+bool parseOptions(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--quick")
+            options.quick = true;
+        else if (arg == "--preprocess")
+            options.preprocessing = true;
+        else if (arg == "--engines" && has_value)
+            options.engines = split(argv[++i]);
+        else if (arg == "--families" && has_value)
+            options.families = split(argv[++i]);
+        else if (arg == "--instances" && has_value)
+            options.instances = std::max(1, atoi(argv[++i]));
+        else if (arg == "--repeat" && has_value)
+            options.repeat = std::max(1, atoi(argv[++i]));
+        else if (arg == "--timeout" && has_value)
+            options.timeout = atof(argv[++i]);
+        else if (arg == "--seed" && has_value)
+            options.seed = (unsigned)atoll(argv[++i]);
+        else if (arg == "--csv" && has_value)
+            options.csv = argv[++i];
+        else if (arg == "--json" && has_value)
+            options.json = argv[++i];
+        else
+        {
+            std::cerr << "未知的选项或缺少参数: " << arg << std::endl;
+            return false;
+        }
+    }
+
+    for (const auto &engine : options.engines)
+    {
+        if (engine != "basic" && engine != "opt1" && engine != "opt2" && engine != "cdcl" && engine != "native")
+        {
+            std::cerr << "未知的求解算法: " << engine << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+RunResult runSAT(const std::string &engine, const BenchInstance &instance, const BenchOptions &options)
+{
+    DeLinkList<cnf_parser::clause> clauses;
+
+    for (const auto &literals : instance.clauses)
+    {
+        cnf_parser::clause clause;
+
+        for (const auto literal : literals)
+        {
+            clause.literals.push_back(literal);
+        }
+
+        clauses.push_back(clause);
+    }
+
+    DPLLSolver solver;
+    std::atomic<bool> cancel(false);
+
+    solver.SetPreprocessing(options.preprocessing);
+    solver.SetCancelFlag(&cancel);
+
+    bool result = false;
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    {
+        Watchdog watchdog(cancel, options.timeout);
+
+        if (engine == "basic")
+            result = solver.BasicSolve(clauses, instance.BoolCount);
+        else if (engine == "opt1")
+            result = solver.OptimizedSolve1(clauses, instance.BoolCount);
+        else if (engine == "opt2")
+            result = solver.OptimizedSolve2(clauses, instance.BoolCount);
+        else
+            result = solver.OptimizedSolve3(clauses, instance.BoolCount);
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    int status = result ? 10 : (solver.WasCancelled() ? 0 : 20);
+
+    return {seconds, solver.GetDecisions(), solver.GetPropagations(), status, solver.IsModelValid()};
+}
+
+RunResult runNative(const BenchInstance &instance)
+{
+    HanidokuEngine engine;
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    bool result = engine.Load(instance.puzzle) && engine.Solve();
+
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    return {seconds, engine.GetDecisions(), engine.GetPropagations(), result ? 10 : 20, true};
+}
+
+// 排序后的第 p 百分位(最近秩)
+double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+
+    size_t rank = (size_t)(p / 100.0 * values.size() + 0.999999);
+
+    return values[std::min(values.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+void writeCSV(std::ostream &out, const std::vector<BenchRow> &rows)
+{
+    out << "family,size,engine,runs,sat,unsat,timeouts,median_ms,p95_ms,decisions_per_sec,propagations_per_sec\n";
+
+    for (const auto &row : rows)
+    {
+        double seconds = std::max(row.total_seconds, 1e-9);
+        char line[512];
+
+        snprintf(line, sizeof(line), "%s,%d,%s,%zu,%d,%d,%d,%.3f,%.3f,%.0f,%.0f\n",
+                 row.family.c_str(), row.size, row.engine.c_str(), row.times.size(), row.sat, row.unsat, row.timeouts,
+                 percentile(row.times, 50) * 1000, percentile(row.times, 95) * 1000, row.decisions / seconds, row.propagations / seconds);
+
+        out << line;
+    }
+}
+
+void writeJSON(std::ostream &out, const std::vector<BenchRow> &rows)
+{
+    out << "[\n";
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        const BenchRow &row = rows[i];
+        double seconds = std::max(row.total_seconds, 1e-9);
+        char line[512];
+
+        snprintf(line, sizeof(line),
+                 "  {\"family\": \"%s\", \"size\": %d, \"engine\": \"%s\", \"runs\": %zu, \"sat\": %d, \"unsat\": %d, \"timeouts\": %d, "
+                 "\"median_ms\": %.3f, \"p95_ms\": %.3f, \"decisions_per_sec\": %.0f, \"propagations_per_sec\": %.0f}%s\n",
+                 row.family.c_str(), row.size, row.engine.c_str(), row.times.size(), row.sat, row.unsat, row.timeouts,
+                 percentile(row.times, 50) * 1000, percentile(row.times, 95) * 1000, row.decisions / seconds, row.propagations / seconds,
+                 i + 1 < rows.size() ? "," : "");
+
+        out << line;
+    }
+
+    out << "]\n";
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    std::vector<BenchRow> rows;
+    int mismatches = 0;
+
+    for (const auto &family : options.families)
+    {
+        std::vector<int> sizes = BenchInstances::Sizes(family, options.quick);
+
+        if (sizes.empty())
+        {
+            std::cerr << "未知的实例族: " << family << std::endl;
+            return 1;
+        }
+
+        for (const auto size : sizes)
+        {
+            std::vector<BenchInstance> instances(options.instances);
+
+            for (int k = 0; k < options.instances; ++k)
+            {
+                BenchInstances::Generate(family, size, options.seed + k, instances[k]);
+            }
+
+            // 每个实例第一次得到的结论, 用于检查各算法结果是否一致
+            std::vector<int> expected(options.instances, 0);
+
+            for (const auto &engine : options.engines)
+            {
+                // 专用引擎只能求解蜂窝数独
+                if (engine == "native" && family != "hanidoku")
+                    continue;
+
+                BenchRow row;
+                row.family = family;
+                row.size = size;
+                row.engine = engine;
+
+                for (int k = 0; k < options.instances; ++k)
+                {
+                    for (int r = 0; r < options.repeat; ++r)
+                    {
+                        RunResult result = engine == "native" ? runNative(instances[k]) : runSAT(engine, instances[k], options);
+
+                        row.times.push_back(result.seconds);
+                        row.total_seconds += result.seconds;
+                        row.decisions += result.decisions;
+                        row.propagations += result.propagations;
+
+                        if (result.status == 10)
+                            ++row.sat;
+                        else if (result.status == 20)
+                            ++row.unsat;
+                        else
+                            ++row.timeouts;
+
+                        if (!result.valid)
+                        {
+                            std::cerr << "解不满足原公式: " << family << " " << size << " 种子 " << instances[k].seed << " 算法 " << engine << std::endl;
+                            ++mismatches;
+                        }
+
+                        if (result.status && expected[k] && result.status != expected[k])
+                        {
+                            std::cerr << "结果不一致: " << family << " " << size << " 种子 " << instances[k].seed << " 算法 " << engine << std::endl;
+                            ++mismatches;
+                        }
+
+                        if (result.status && !expected[k])
+                            expected[k] = result.status;
+                    }
+                }
+
+                std::cerr << family << " " << size << " " << engine << ": 中位数 " << percentile(row.times, 50) * 1000 << " ms, 超时 " << row.timeouts << std::endl;
+
+                rows.push_back(row);
+            }
+        }
+    }
+
+    if (options.csv.empty() || options.csv == "-")
+        writeCSV(std::cout, rows);
+    else
+    {
+        std::ofstream outFile(options.csv);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败: " << options.csv << std::endl;
+            return 1;
+        }
+
+        writeCSV(outFile, rows);
+    }
+
+    if (!options.json.empty())
+    {
+        std::ofstream outFile(options.json);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败: " << options.json << std::endl;
+            return 1;
+        }
+
+        writeJSON(outFile, rows);
+    }
+
+    return mismatches ? 2 : 0;
+}
@@ -0,0 +1,250 @@
+#ifndef BENCH_INSTANCES_H
+#define BENCH_INSTANCES_H
+
+#include "../include/hanidoku_rules.h"
+#include "../include/hanidoku_engine.h"
+#include "../include/hanidoku_generator.h"
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// 基准测试用的标准实例族, 同一族、规模与种子总是生成同一个实例
+// size 的含义随族而定: 变元数、洞数、方程数、顶点数或空格数
+struct BenchInstance
+{
+    std::string family;
+    int size;
+    unsigned seed;
+    int BoolCount;
+    std::vector<std::vector<int>> clauses;
+    std::string puzzle; // 仅蜂窝数独: 题目, '0' 表示空格
+};
+
+class BenchInstances
+{
+public:
+    static const std::vector<std::string> &Families()
+    {
+        static const std::vector<std::string> families = {"random3sat", "pigeonhole", "parity", "coloring", "hanidoku"};
+
+        return families;
+    }
+
+    // 各族默认的规模, quick 时使用较小的规模
+    static std::vector<int> Sizes(const std::string &family, bool quick)
+    {
+        if (family == "random3sat")
+            return quick ? std::vector<int>{30, 50} : std::vector<int>{50, 75, 100};
+        if (family == "pigeonhole")
+            return quick ? std::vector<int>{4, 5} : std::vector<int>{5, 6, 7};
+        if (family == "parity")
+            return quick ? std::vector<int>{10, 16} : std::vector<int>{16, 24, 32};
+        if (family == "coloring")
+            return quick ? std::vector<int>{15, 20} : std::vector<int>{20, 30, 40};
+        if (family == "hanidoku")
+            return quick ? std::vector<int>{20, 35} : std::vector<int>{20, 35, 50};
+
+        return {};
+    }
+
+    // 生成实例, 未知的族返回 false
+    static bool Generate(const std::string &family, int size, unsigned seed, BenchInstance &instance)
+    {
+        const auto &families = Families();
+        unsigned index = std::find(families.begin(), families.end(), family) - families.begin();
+
+        std::seed_seq sequence{seed, (unsigned)size, index};
+        std::mt19937 random(sequence);
+
+        instance.family = family;
+        instance.size = size;
+        instance.seed = seed;
+        instance.clauses.clear();
+        instance.puzzle.clear();
+
+        if (family == "random3sat")
+            Random3SAT(instance, size, random);
+        else if (family == "pigeonhole")
+            Pigeonhole(instance, size);
+        else if (family == "parity")
+            Parity(instance, size, random);
+        else if (family == "coloring")
+            Coloring(instance, size, random);
+        else if (family == "hanidoku")
+            Hanidoku(instance, size, random);
+        else
+            return false;
+
+        return true;
+    }
+
+private:
+    // 随机 3-SAT, 子句数与变元数之比取相变点 4.26
+    static void Random3SAT(BenchInstance &instance, int n, std::mt19937 &random)
+    {
+        int m = (int)(4.26 * n + 0.5);
+
+        instance.BoolCount = n;
+
+        for (int i = 0; i < m; ++i)
+        {
+            std::vector<int> clause;
+
+            while (clause.size() < 3)
+            {
+                int var = random() % n + 1;
+
+                if (std::find(clause.begin(), clause.end(), var) == clause.end() && std::find(clause.begin(), clause.end(), -var) == clause.end())
+                    clause.push_back(random() & 1 ? var : -var);
+            }
+
+            instance.clauses.push_back(clause);
+        }
+    }
+
+    // 鸽巢原理: holes + 1 只鸽子放进 holes 个洞, 无解
+    static void Pigeonhole(BenchInstance &instance, int holes)
+    {
+        int pigeons = holes + 1;
+        auto var = [holes](int p, int h)
+        { return p * holes + h + 1; };
+
+        instance.BoolCount = pigeons * holes;
+
+        for (int p = 0; p < pigeons; ++p)
+        {
+            std::vector<int> clause;
+
+            for (int h = 0; h < holes; ++h)
+            {
+                clause.push_back(var(p, h));
+            }
+
+            instance.clauses.push_back(clause);
+        }
+
+        for (int h = 0; h < holes; ++h)
+        {
+            for (int p1 = 0; p1 < pigeons; ++p1)
+            {
+                for (int p2 = p1 + 1; p2 < pigeons; ++p2)
+                {
+                    instance.clauses.push_back({-var(p1, h), -var(p2, h)});
+                }
+            }
+        }
+    }
+
+    // 随机异或方程组: n 个变元上的 n 个三元异或方程, 每个方程编码为4个子句
+    static void Parity(BenchInstance &instance, int n, std::mt19937 &random)
+    {
+        instance.BoolCount = n;
+
+        for (int i = 0; i < n; ++i)
+        {
+            int vars[3];
+
+            for (int k = 0; k < 3; ++k)
+            {
+                do
+                {
+                    vars[k] = random() % n + 1;
+                } while (std::find(vars, vars + k, vars[k]) != vars + k);
+            }
+
+            int parity = random() & 1;
+
+            // 排除所有奇偶性不符的赋值
+            for (int mask = 0; mask < 8; ++mask)
+            {
+                if (__builtin_popcount(mask) % 2 == parity)
+                    continue;
+
+                std::vector<int> clause;
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    clause.push_back(mask >> k & 1 ? -vars[k] : vars[k]);
+                }
+
+                instance.clauses.push_back(clause);
+            }
+        }
+    }
+
+    // 随机图三着色, 平均度数 4.6 接近相变点
+    static void Coloring(BenchInstance &instance, int n, std::mt19937 &random)
+    {
+        const int colors = 3;
+        int edges = (int)(2.3 * n + 0.5);
+        auto var = [](int v, int c)
+        { return v * colors + c + 1; };
+
+        instance.BoolCount = n * colors;
+
+        for (int v = 0; v < n; ++v)
+        {
+            std::vector<int> clause;
+
+            for (int c = 0; c < colors; ++c)
+            {
+                clause.push_back(var(v, c));
+            }
+
+            instance.clauses.push_back(clause);
+
+            for (int c1 = 0; c1 < colors; ++c1)
+            {
+                for (int c2 = c1 + 1; c2 < colors; ++c2)
+                {
+                    instance.clauses.push_back({-var(v, c1), -var(v, c2)});
+                }
+            }
+        }
+
+        std::vector<std::pair<int, int>> used;
+
+        while ((int)used.size() < edges && (int)used.size() < n * (n - 1) / 2)
+        {
+            int a = random() % n;
+            int b = random() % n;
+
+            if (a == b)
+                continue;
+
+            std::pair<int, int> edge(std::min(a, b), std::max(a, b));
+
+            if (std::find(used.begin(), used.end(), edge) != used.end())
+                continue;
+
+            used.push_back(edge);
+
+            for (int c = 0; c < colors; ++c)
+            {
+                instance.clauses.push_back({-var(a, c), -var(b, c)});
+            }
+        }
+    }
+
+    // 蜂窝数独: 随机终盘的随机对称变换, 挖 blanks 个洞并保持解唯一
+    static void Hanidoku(BenchInstance &instance, int blanks, std::mt19937 &random)
+    {
+        int ending = random() % 20;
+        int variant = random() % HanidokuGenerator::Variants;
+        std::string grid = HanidokuGenerator::Transform(HanidokuEndings[ending], variant);
+
+        HanidokuEngine engine;
+        instance.puzzle = HanidokuGenerator::DigHoles(engine, grid, blanks, random);
+        instance.BoolCount = HanidokuRules::BoolCount;
+        instance.clauses = HanidokuRules::Clauses();
+
+        for (int pos = 0; pos < HanidokuGeometry::Cells; ++pos)
+        {
+            if (instance.puzzle[pos] != '0')
+                instance.clauses.push_back({HanidokuGeometry::Variable(pos, instance.puzzle[pos] - '0')});
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,474 @@
+#include "../include/dpll_solver.h"
+#include "../include/cnf_parser.h"
+#include "../include/cnf_cache.h"
+#include "../include/list.h"
+#include "instances.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 求解器内核的微基准测试, 分别测量 cnf 读取速度(文本与二进制缓存)、单子句传播每次赋值的代价、分裂策略每次决策的代价与子句链表的复制代价
+// 写法仿照 google-benchmark: 每个基准自动增加迭代次数直到运行时间超过 --min-time, 准备工作用 PauseTiming/ResumeTiming 排除在计时之外
+// 用法: microbench [--filter 子串] [--min-time 秒]
+
+class MicroState
+{
+public:
+    MicroState(long long iterations, int arg) : iterations(iterations), arg(arg) {}
+
+    long long Iterations() const
+    {
+        return iterations;
+    }
+
+    // 规模参数
+    int Arg() const
+    {
+        return arg;
+    }
+
+    void PauseTiming()
+    {
+        pause_start = std::chrono::high_resolution_clock::now();
+    }
+
+    void ResumeTiming()
+    {
+        paused += std::chrono::high_resolution_clock::now() - pause_start;
+    }
+
+    // 处理的元素数(赋值、决策、文字等), 用于计算每个元素的代价
+    void SetItemsProcessed(long long items)
+    {
+        this->items = items;
+    }
+
+    void SetBytesProcessed(long long bytes)
+    {
+        this->bytes = bytes;
+    }
+
+    long long GetItems() const
+    {
+        return items;
+    }
+
+    long long GetBytes() const
+    {
+        return bytes;
+    }
+
+    std::chrono::high_resolution_clock::duration GetPaused() const
+    {
+        return paused;
+    }
+
+private:
+    long long iterations;
+    int arg;
+    long long items = 0;
+    long long bytes = 0;
+    std::chrono::high_resolution_clock::time_point pause_start;
+    std::chrono::high_resolution_clock::duration paused{0};
+};
+
+struct MicroBenchmark
+{
+    std::string name;
+    std::function<void(MicroState &)> function;
+    std::vector<int> args;
+    std::string item_name; // 每个元素的名称, 为空时不输出每个元素的代价
+};
+
+// 让编译器认为 value 被读取, 防止被测的调用被优化掉
+template <typename T>
+inline void DoNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+// 访问 DPLLSolver 的内核
+class DPLLKernels
+{
+public:
+    static void UnitClausePropagation(DPLLSolver &solver, DeLinkList<cnf_parser::clause> &clauses, LiteralStatus assignment[])
+    {
+        solver.UnitClausePropagation(clauses, assignment);
+    }
+
+    static int SelectLiteral(DPLLSolver &solver, const std::pair<int, int> counter[], int BoolCount)
+    {
+        return solver.SelectLiteral(counter, BoolCount);
+    }
+
+    static int Branching(DPLLSolver &solver, int min_size, DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        return solver.Branching(min_size, clauses, BoolCount);
+    }
+
+    static long long GetPropagations(const DPLLSolver &solver)
+    {
+        return solver.stats.propagations;
+    }
+};
+
+// 随机 3-SAT 实例转换为子句链表
+DeLinkList<cnf_parser::clause> randomClauses(int n, BenchInstance &instance)
+{
+    BenchInstances::Generate("random3sat", n, 1, instance);
+
+    DeLinkList<cnf_parser::clause> clauses;
+
+    for (const auto &literals : instance.clauses)
+    {
+        cnf_parser::clause clause;
+
+        for (const auto literal : literals)
+        {
+            clause.literals.push_back(literal);
+        }
+
+        clauses.push_back(clause);
+    }
+
+    return clauses;
+}
+
+// cnf 文件读取速度
+void BM_ReadCNFFile(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    BenchInstances::Generate("random3sat", state.Arg(), 1, instance);
+
+    std::string filename = (std::filesystem::temp_directory_path() / "microbench.cnf").string();
+
+    {
+        std::ofstream outFile(filename);
+
+        outFile << "c microbench\n";
+        outFile << "p cnf " << instance.BoolCount << " " << instance.clauses.size() << "\n";
+
+        for (const auto &clause : instance.clauses)
+        {
+            for (const auto literal : clause)
+            {
+                outFile << literal << " ";
+            }
+
+            outFile << "0\n";
+        }
+    }
+
+    long long file_size = std::filesystem::file_size(filename);
+
+    // 只测量文本解析
+    cnf_parser parser;
+    parser.SetBinaryCache(false);
+
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        DeLinkList<cnf_parser::clause> clauses;
+        parser.ReadCNFFile(filename, clauses);
+
+        state.PauseTiming();
+        clauses.clear();
+        state.ResumeTiming();
+    }
+
+    state.PauseTiming();
+    std::filesystem::remove(filename);
+    state.ResumeTiming();
+
+    state.SetBytesProcessed(file_size * state.Iterations());
+}
+
+// 从二进制缓存读取, 按对应 cnf 文件的大小计算速度, 便于与文本解析比较
+void BM_ReadCNFCache(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    BenchInstances::Generate("random3sat", state.Arg(), 1, instance);
+
+    std::string filename = (std::filesystem::temp_directory_path() / "microbench_cache.cnf").string();
+
+    {
+        std::ofstream outFile(filename);
+
+        outFile << "c microbench\n";
+        outFile << "p cnf " << instance.BoolCount << " " << instance.clauses.size() << "\n";
+
+        for (const auto &clause : instance.clauses)
+        {
+            for (const auto literal : clause)
+            {
+                outFile << literal << " ";
+            }
+
+            outFile << "0\n";
+        }
+    }
+
+    long long file_size = std::filesystem::file_size(filename);
+
+    // 第一次读取写出缓存
+    cnf_parser parser;
+
+    {
+        DeLinkList<cnf_parser::clause> clauses;
+        parser.ReadCNFFile(filename, clauses);
+    }
+
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        DeLinkList<cnf_parser::clause> clauses;
+        parser.ReadCNFFile(filename, clauses);
+
+        state.PauseTiming();
+        clauses.clear();
+        state.ResumeTiming();
+    }
+
+    state.PauseTiming();
+
+    if (!parser.IsLoadedFromCache())
+        std::cerr << "未能从二进制缓存读取" << std::endl;
+
+    std::filesystem::remove(filename);
+    std::filesystem::remove(CNFCache::FileName(filename));
+    state.ResumeTiming();
+
+    state.SetBytesProcessed(file_size * state.Iterations());
+}
+
+// 单子句传播: 在随机 3-SAT 实例上加入 n/10 个单子句, 测量每次赋值的代价
+void BM_UnitClausePropagation(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    DeLinkList<cnf_parser::clause> clauses = randomClauses(state.Arg(), instance);
+
+    std::mt19937 random(1);
+    std::vector<int> vars(instance.BoolCount);
+
+    for (int i = 0; i < instance.BoolCount; ++i)
+    {
+        vars[i] = i + 1;
+    }
+
+    std::shuffle(vars.begin(), vars.end(), random);
+
+    for (int i = 0; i < instance.BoolCount / 10; ++i)
+    {
+        cnf_parser::clause clause;
+        clause.literals.push_back(random() & 1 ? vars[i] : -vars[i]);
+        clauses.push_front(clause);
+    }
+
+    DPLLSolver solver;
+    std::vector<LiteralStatus> assignment(instance.BoolCount + 1, LiteralStatus::Unassigned);
+
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        state.PauseTiming();
+        auto copy = std::make_unique<DeLinkList<cnf_parser::clause>>(clauses);
+        state.ResumeTiming();
+
+        DPLLKernels::UnitClausePropagation(solver, *copy, assignment.data());
+
+        state.PauseTiming();
+        copy.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(DPLLKernels::GetPropagations(solver));
+}
+
+// 基础分裂策略: 只测量在出现次数表上选择文字的代价
+void BM_SelectLiteral(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    BenchInstances::Generate("random3sat", state.Arg(), 1, instance);
+
+    std::vector<std::pair<int, int>> counter(instance.BoolCount + 1, {0, 0});
+
+    for (const auto &clause : instance.clauses)
+    {
+        for (const auto literal : clause)
+        {
+            literal > 0 ? counter[std::abs(literal)].first++ : counter[std::abs(literal)].second++;
+        }
+    }
+
+    DPLLSolver solver;
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        DoNotOptimize(DPLLKernels::SelectLiteral(solver, counter.data(), instance.BoolCount));
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+
+// MOM 分裂策略: 包括统计最短子句中的出现次数
+void BM_Branching(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    DeLinkList<cnf_parser::clause> clauses = randomClauses(state.Arg(), instance);
+
+    DPLLSolver solver;
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        DoNotOptimize(DPLLKernels::Branching(solver, 3, clauses, instance.BoolCount));
+    }
+
+    state.SetItemsProcessed(state.Iterations());
+}
+
+// 子句链表的复制(每个搜索结点都要复制一次), 按复制的文字数计
+void BM_DeLinkListCopy(MicroState &state)
+{
+    // 准备工作不计时
+    state.PauseTiming();
+
+    BenchInstance instance;
+    DeLinkList<cnf_parser::clause> clauses = randomClauses(state.Arg(), instance);
+
+    state.ResumeTiming();
+
+    for (long long i = 0; i < state.Iterations(); ++i)
+    {
+        auto copy = std::make_unique<DeLinkList<cnf_parser::clause>>(clauses);
+
+        state.PauseTiming();
+        copy.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(3LL * instance.clauses.size() * state.Iterations());
+}
+
+// 增加迭代次数直到计时超过 min_time, 输出每次迭代的时间与吞吐量
+void runBenchmark(const MicroBenchmark &benchmark, int arg, double min_time)
+{
+    long long iterations = 1;
+
+    while (true)
+    {
+        MicroState state(iterations, arg);
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        benchmark.function(state);
+        auto elapsed = std::chrono::high_resolution_clock::now() - start_time - state.GetPaused();
+
+        double seconds = std::chrono::duration<double>(elapsed).count();
+
+        if (seconds < min_time && iterations < 1000000000LL)
+        {
+            // 按已测得的速度估计需要的迭代次数, 每次至多增加到10倍
+            double estimate = seconds > 0 ? min_time * 1.4 / seconds * iterations : iterations * 10.0;
+            iterations = std::max(iterations + 1, std::min(iterations * 10, (long long)estimate));
+            continue;
+        }
+
+        char line[256];
+        std::string name = benchmark.name + "/" + std::to_string(arg);
+        std::string throughput;
+
+        if (state.GetBytes())
+            throughput = std::to_string((long long)(state.GetBytes() / seconds / 1e6 + 0.5)) + " MB/s";
+        else if (state.GetItems() && !benchmark.item_name.empty())
+        {
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "%.2f ns/%s", seconds * 1e9 / state.GetItems(), benchmark.item_name.c_str());
+            throughput = buffer;
+        }
+
+        snprintf(line, sizeof(line), "%-32s %14.0f ns %12lld   %s", name.c_str(), seconds * 1e9 / iterations, iterations, throughput.c_str());
+        std::cout << line << std::endl;
+
+        return;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string filter;
+    double min_time = 0.5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc)
+            min_time = atof(argv[++i]);
+        else
+        {
+            std::cerr << "用法: " << argv[0] << " [--filter 子串] [--min-time 秒]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<MicroBenchmark> benchmarks = {
+        {"ReadCNFFile", BM_ReadCNFFile, {1000, 20000}, ""},
+        {"ReadCNFCache", BM_ReadCNFCache, {1000, 20000}, ""},
+        {"UnitClausePropagation", BM_UnitClausePropagation, {100, 1000}, "assignment"},
+        {"SelectLiteral", BM_SelectLiteral, {100, 1000}, "decision"},
+        {"Branching", BM_Branching, {100, 1000}, "decision"},
+        {"DeLinkListCopy", BM_DeLinkListCopy, {100, 1000}, "literal"},
+    };
+
+    char header[256];
+    snprintf(header, sizeof(header), "%-32s %17s %12s   %s", "Benchmark", "Time", "Iterations", "Throughput");
+    std::cout << header << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (const auto &benchmark : benchmarks)
+    {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        for (const auto arg : benchmark.args)
+        {
+            runBenchmark(benchmark, arg, min_time);
+        }
+    }
+
+    return 0;
+}
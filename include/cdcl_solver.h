@@ -0,0 +1,1400 @@
+#ifndef CDCL_SOLVER_H
+#define CDCL_SOLVER_H
+
+#include "cnf_parser.h"
+#include "list.h"
+#include "trace.h"
+#include "progress_reporter.h"
+#include "drat_writer.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+// 冲突驱动子句学习(CDCL)求解器
+// 双文字监视的单子句传播、1UIP冲突分析、VSIDS分裂策略与Luby重启
+// 在重启时暂停搜索, 按搜索工作量的一定比例穿插执行化简(inprocessing): 子句包含/自包含消解、失败文字试探与子句活化(vivification)
+class CDCLSolver
+{
+public:
+    CDCLSolver() : BoolCount(0), unsat(false), inprocessing(true), inprocess_effort(0.1), inprocess_interval(2000), cancel_flag(nullptr), progress_counter(nullptr), proof(nullptr), proof_units(0), cancelled(false) {}
+
+    bool Solve(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        Load(clauses, BoolCount);
+
+        bool result = Search();
+
+        // 无解时以空子句结束证明
+        if (unsat)
+            ProofAdd(std::vector<int>());
+
+        return result;
+    }
+
+    // 统计模型数量, 找到 limit 个模型后停止
+    // 每找到一个模型就加入阻塞子句排除它在投影变元 1..projection 上的取值, 学习子句与活跃度在各次搜索间保留
+    // projection 为0时投影到全部变元; GetAssignment 返回最后找到的模型
+    long long CountSolutions(DeLinkList<cnf_parser::clause> &clauses, int BoolCount, long long limit, int projection = 0)
+    {
+        // 阻塞子句不是原公式的推论, 计数时不输出证明
+        DRATWriter *saved_proof = proof;
+        proof = nullptr;
+
+        struct RestoreProof
+        {
+            CDCLSolver *solver;
+            DRATWriter *saved;
+
+            ~RestoreProof()
+            {
+                solver->proof = saved;
+            }
+        } restore{this, saved_proof};
+
+        Load(clauses, BoolCount);
+
+        if (projection <= 0 || projection > BoolCount)
+            projection = BoolCount;
+
+        long long count = 0;
+
+        while (count < limit && Search())
+        {
+            if (++count == limit)
+                break;
+
+            std::vector<int> blocking;
+
+            if (projection == BoolCount)
+            {
+                // 全部变元由决策文字经单子句传播确定, 阻塞决策文字即可
+                for (const auto start : trail_lim)
+                {
+                    blocking.push_back(-trail[start]);
+                }
+            }
+            else
+            {
+                for (int var = 1; var <= projection; ++var)
+                {
+                    blocking.push_back(values[var] > 0 ? -var : var);
+                }
+            }
+
+            // 模型完全由第0层确定, 不存在其他模型
+            if (blocking.empty())
+                break;
+
+            Backtrack(0);
+            AddClause(blocking);
+        }
+
+        return count;
+    }
+
+    std::vector<LiteralStatus> GetAssignment()
+    {
+        return this->assignment_result;
+    }
+
+    // 开启或关闭搜索过程中的化简
+    void SetInprocessing(bool enable)
+    {
+        this->inprocessing = enable;
+    }
+
+    bool IsInprocessing() const
+    {
+        return this->inprocessing;
+    }
+
+    // 设置化简的工作量占上一轮以来搜索工作量的比例, 以及两轮化简之间的最少冲突次数
+    void SetInprocessEffort(double effort, long long interval)
+    {
+        this->inprocess_effort = effort;
+        this->inprocess_interval = interval;
+    }
+
+    // 设置取消标志, 标志被置为true后在下一次冲突时返回false(结果不可信)
+    void SetCancelFlag(std::atomic<bool> *cancel_flag)
+    {
+        this->cancel_flag = cancel_flag;
+    }
+
+    // 设置进度计数器, 每发生一次冲突加一
+    void SetProgressCounter(std::atomic<long long> *progress_counter)
+    {
+        this->progress_counter = progress_counter;
+    }
+
+    // 设置 DRAT 证明输出, 为空时不输出; 证明针对传给 Solve 的子句集合, 因此求解前不能做预处理
+    void SetProof(DRATWriter *proof)
+    {
+        this->proof = proof;
+    }
+
+    // 设置进度输出间隔(秒), 不大于0时关闭
+    void SetProgressInterval(double interval, std::ostream *out = &std::cout)
+    {
+        progress_reporter.SetInterval(interval, out);
+    }
+
+    // 上一次搜索是否因取消标志而提前返回(此时返回的false不表示无解)
+    bool WasCancelled() const
+    {
+        return this->cancelled;
+    }
+
+    long long GetConflicts() const
+    {
+        return this->conflicts;
+    }
+
+    long long GetDecisions() const
+    {
+        return this->decisions;
+    }
+
+    // 赋值的文字数(包括决策)
+    long long GetPropagations() const
+    {
+        return this->propagations;
+    }
+
+    long long GetRestarts() const
+    {
+        return this->restarts;
+    }
+
+    // 学习到的子句数(包括单子句)
+    long long GetLearnedClauses() const
+    {
+        return this->learned_clauses;
+    }
+
+    long long GetMaxLevel() const
+    {
+        return this->max_level;
+    }
+
+    long long GetInprocessRounds() const
+    {
+        return this->inprocess_rounds;
+    }
+
+    long long GetVivifiedLiterals() const
+    {
+        return this->vivified_literals;
+    }
+
+private:
+    // 子句: 前两个文字为监视文字, 作为原因子句时第一个文字为被蕴含的文字
+    struct Clause
+    {
+        std::vector<int> literals;
+        bool learnt;
+        bool removed;
+        bool vivified;
+        int lbd;
+    };
+
+    int BoolCount;
+    bool unsat;
+    bool inprocessing;
+    double inprocess_effort;
+    long long inprocess_interval;
+    std::atomic<bool> *cancel_flag;
+    std::atomic<long long> *progress_counter;
+    ProgressReporter progress_reporter;
+    DRATWriter *proof;
+    size_t proof_units;                         // 已作为单子句写入证明的第0层赋值数
+    bool cancelled;
+    std::vector<Clause> clause_db;              // 原始子句与学习子句
+    std::vector<std::vector<int>> watches;      // 文字 -> 监视该文字的子句
+    std::vector<signed char> values;            // 变元取值: 1 真, -1 假, 0 未赋值
+    std::vector<int> level;                     // 变元被赋值时的决策层
+    std::vector<int> reason;                    // 变元的原因子句, 决策变元为-1
+    std::vector<int> trail;                     // 赋值序列
+    std::vector<int> trail_lim;                 // 每一决策层在赋值序列中的起点
+    size_t propagated;                          // 已传播到的赋值序列位置
+    std::vector<double> activity;               // VSIDS 活跃度
+    double var_inc;
+    std::vector<int> heap;                      // 按活跃度排序的大根堆
+    std::vector<int> heap_position;             // 变元在堆中的位置, -1表示不在堆中
+    std::vector<signed char> phase;             // 保存的相位
+    std::vector<signed char> seen;              // 冲突分析时使用的标记
+    std::vector<LiteralStatus> assignment_result;
+
+    long long conflicts;
+    long long decisions;
+    long long propagations;
+    long long restarts;
+    long long learned_clauses;
+    long long max_level;                        // 搜索中出现过的最大决策层
+    long long ticks;                            // 传播时访问子句的次数, 作为工作量的度量
+    long long next_reduce;
+    long long restart_countdown;
+    long long luby_index;
+    long long next_inprocess;
+    long long inprocess_rounds;
+    long long last_inprocess_ticks;
+    long long vivified_literals;                // 活化删去的文字数
+    int probe_next;                             // 下一轮试探的起始变元
+
+    static int Code(int literal)
+    {
+        return 2 * std::abs(literal) + (literal < 0);
+    }
+
+    int Value(int literal) const
+    {
+        int value = values[std::abs(literal)];
+
+        return literal > 0 ? value : -value;
+    }
+
+    int DecisionLevel() const
+    {
+        return trail_lim.size();
+    }
+
+    // 读入子句集合, 初始化求解状态
+    void Load(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        this->BoolCount = BoolCount;
+        this->unsat = false;
+        this->cancelled = false;
+
+        clause_db.clear();
+        watches.assign(2 * BoolCount + 2, std::vector<int>());
+        values.assign(BoolCount + 1, 0);
+        level.assign(BoolCount + 1, 0);
+        reason.assign(BoolCount + 1, -1);
+        trail.clear();
+        trail_lim.clear();
+        propagated = 0;
+        activity.assign(BoolCount + 1, 0.0);
+        var_inc = 1.0;
+        phase.assign(BoolCount + 1, -1);
+        seen.assign(BoolCount + 1, 0);
+        heap.clear();
+        heap_position.assign(BoolCount + 1, -1);
+
+        conflicts = 0;
+        decisions = 0;
+        propagations = 0;
+        restarts = 0;
+        learned_clauses = 0;
+        max_level = 0;
+        ticks = 0;
+        next_reduce = 2000;
+        luby_index = 0;
+        restart_countdown = 100 * Luby(luby_index);
+        next_inprocess = inprocess_interval;
+        inprocess_rounds = 0;
+        last_inprocess_ticks = 0;
+        vivified_literals = 0;
+        probe_next = 1;
+        proof_units = 0;
+        progress_reporter.Start();
+
+        for (int var = 1; var <= BoolCount; ++var)
+        {
+            HeapInsert(var);
+        }
+
+        for (auto it_clause = clauses.begin(); it_clause != clauses.end() && !unsat; ++it_clause)
+        {
+            std::vector<int> literals;
+
+            for (auto it_literal = (*it_clause).literals.begin(); it_literal != (*it_clause).literals.end(); ++it_literal)
+            {
+                literals.push_back(*it_literal);
+            }
+
+            AddClause(literals);
+        }
+    }
+
+    // 在第0层加入原始子句
+    void AddClause(std::vector<int> literals)
+    {
+        std::vector<int> original;
+
+        if (proof)
+            original = literals;
+
+        std::sort(literals.begin(), literals.end());
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+
+        std::vector<int> normalized;
+
+        for (const auto literal : literals)
+        {
+            // 已满足或为重言式
+            if (Value(literal) == 1 || std::binary_search(literals.begin(), literals.end(), -literal))
+                return;
+
+            if (Value(literal) == 0)
+                normalized.push_back(literal);
+        }
+
+        // 去掉了重复或为假的文字时, 证明中用化简后的子句替换原子句
+        if (proof && normalized.size() != original.size() && !normalized.empty())
+        {
+            ProofAdd(normalized);
+            ProofDelete(original);
+        }
+
+        if (normalized.empty())
+        {
+            unsat = true;
+            return;
+        }
+
+        if (normalized.size() == 1)
+        {
+            Enqueue(normalized[0], -1);
+
+            if (Propagate() >= 0)
+                unsat = true;
+
+            return;
+        }
+
+        AttachClause(normalized, false, 0);
+    }
+
+    int AttachClause(const std::vector<int> &literals, bool learnt, int lbd)
+    {
+        int c = clause_db.size();
+
+        clause_db.push_back({literals, learnt, false, false, lbd});
+        watches[Code(literals[0])].push_back(c);
+        watches[Code(literals[1])].push_back(c);
+
+        return c;
+    }
+
+    void Enqueue(int literal, int from)
+    {
+        int var = std::abs(literal);
+
+        values[var] = (literal > 0 ? 1 : -1);
+        level[var] = DecisionLevel();
+        reason[var] = from;
+        trail.push_back(literal);
+        ++propagations;
+    }
+
+    // 单子句传播, 返回冲突子句的下标, 没有冲突返回-1
+    int Propagate()
+    {
+        TraceScope trace(TracePhase::Propagate);
+
+        while (propagated < trail.size())
+        {
+            int false_literal = -trail[propagated++];
+            std::vector<int> &list = watches[Code(false_literal)];
+            size_t i = 0, j = 0;
+
+            while (i < list.size())
+            {
+                int c = list[i++];
+                Clause &clause = clause_db[c];
+
+                ++ticks;
+
+                // 被删除的子句顺便移出监视表
+                if (clause.removed)
+                    continue;
+
+                std::vector<int> &literals = clause.literals;
+
+                if (literals[0] == false_literal)
+                    std::swap(literals[0], literals[1]);
+
+                if (Value(literals[0]) == 1)
+                {
+                    list[j++] = c;
+                    continue;
+                }
+
+                // 寻找新的监视文字
+                bool found = false;
+
+                for (size_t k = 2; k < literals.size(); ++k)
+                {
+                    if (Value(literals[k]) != -1)
+                    {
+                        std::swap(literals[1], literals[k]);
+                        watches[Code(literals[1])].push_back(c);
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (found)
+                    continue;
+
+                list[j++] = c;
+
+                if (Value(literals[0]) == -1)
+                {
+                    while (i < list.size())
+                    {
+                        list[j++] = list[i++];
+                    }
+
+                    list.resize(j);
+                    propagated = trail.size();
+
+                    return c;
+                }
+
+                Enqueue(literals[0], c);
+            }
+
+            list.resize(j);
+        }
+
+        return -1;
+    }
+
+    void NewDecisionLevel()
+    {
+        trail_lim.push_back(trail.size());
+    }
+
+    // 回溯到指定决策层, 保存相位并把变元放回堆中
+    void Backtrack(int target)
+    {
+        if (DecisionLevel() <= target)
+            return;
+
+        for (int i = (int)trail.size() - 1; i >= trail_lim[target]; --i)
+        {
+            int var = std::abs(trail[i]);
+
+            phase[var] = values[var];
+            values[var] = 0;
+            reason[var] = -1;
+
+            if (heap_position[var] < 0)
+                HeapInsert(var);
+        }
+
+        trail.resize(trail_lim[target]);
+        trail_lim.resize(target);
+        propagated = trail.size();
+    }
+
+    // 1UIP 冲突分析, 得到学习子句与回溯层
+    void Analyze(int conflict, std::vector<int> &learnt, int &backtrack_level)
+    {
+        TraceScope trace(TracePhase::Analyze);
+
+        learnt.clear();
+        learnt.push_back(0);
+
+        int counter = 0;
+        int literal = 0;
+        int index = trail.size() - 1;
+        int c = conflict;
+
+        do
+        {
+            for (const auto other : clause_db[c].literals)
+            {
+                int var = std::abs(other);
+
+                if (other == literal || seen[var] || level[var] == 0)
+                    continue;
+
+                seen[var] = 1;
+                BumpVariable(var);
+
+                if (level[var] == DecisionLevel())
+                    ++counter;
+                else
+                    learnt.push_back(other);
+            }
+
+            while (!seen[std::abs(trail[index])])
+            {
+                --index;
+            }
+
+            literal = trail[index--];
+            c = reason[std::abs(literal)];
+            seen[std::abs(literal)] = 0;
+            --counter;
+        } while (counter > 0);
+
+        learnt[0] = -literal;
+
+        // 局部化简: 原因子句中其余文字都已在学习子句中的文字是多余的
+        std::vector<int> analyzed(learnt.begin() + 1, learnt.end());
+        size_t j = 1;
+
+        for (size_t i = 1; i < learnt.size(); ++i)
+        {
+            int from = reason[std::abs(learnt[i])];
+            bool redundant = (from >= 0);
+
+            if (redundant)
+            {
+                for (const auto other : clause_db[from].literals)
+                {
+                    int var = std::abs(other);
+
+                    if (var != std::abs(learnt[i]) && !seen[var] && level[var] > 0)
+                    {
+                        redundant = false;
+                        break;
+                    }
+                }
+            }
+
+            if (!redundant)
+                learnt[j++] = learnt[i];
+        }
+
+        learnt.resize(j);
+
+        for (const auto other : analyzed)
+        {
+            seen[std::abs(other)] = 0;
+        }
+
+        // 第二个监视文字取决策层最高的文字
+        backtrack_level = 0;
+
+        for (size_t i = 1; i < learnt.size(); ++i)
+        {
+            if (level[std::abs(learnt[i])] > backtrack_level)
+            {
+                backtrack_level = level[std::abs(learnt[i])];
+                std::swap(learnt[1], learnt[i]);
+            }
+        }
+    }
+
+    // 学习子句涉及的不同决策层数(LBD)
+    int ComputeLbd(const std::vector<int> &literals)
+    {
+        std::vector<int> levels;
+
+        for (const auto literal : literals)
+        {
+            levels.push_back(level[std::abs(literal)]);
+        }
+
+        std::sort(levels.begin(), levels.end());
+
+        return std::unique(levels.begin(), levels.end()) - levels.begin();
+    }
+
+    void BumpVariable(int var)
+    {
+        if ((activity[var] += var_inc) > 1e100)
+        {
+            for (int i = 1; i <= BoolCount; ++i)
+            {
+                activity[i] *= 1e-100;
+            }
+
+            var_inc *= 1e-100;
+        }
+
+        if (heap_position[var] >= 0)
+            HeapUp(heap_position[var]);
+    }
+
+    // 选择活跃度最高的未赋值变元, 全部赋值时返回0
+    int PickBranchLiteral()
+    {
+        TraceScope trace(TracePhase::Branch);
+
+        while (!heap.empty())
+        {
+            int var = HeapPop();
+
+            if (values[var] == 0)
+                return phase[var] > 0 ? var : -var;
+        }
+
+        return 0;
+    }
+
+    void HeapUp(int i)
+    {
+        int var = heap[i];
+
+        while (i > 0 && activity[heap[(i - 1) / 2]] < activity[var])
+        {
+            heap[i] = heap[(i - 1) / 2];
+            heap_position[heap[i]] = i;
+            i = (i - 1) / 2;
+        }
+
+        heap[i] = var;
+        heap_position[var] = i;
+    }
+
+    void HeapDown(int i)
+    {
+        int var = heap[i];
+        int size = heap.size();
+
+        while (2 * i + 1 < size)
+        {
+            int child = 2 * i + 1;
+
+            if (child + 1 < size && activity[heap[child + 1]] > activity[heap[child]])
+                ++child;
+
+            if (activity[heap[child]] <= activity[var])
+                break;
+
+            heap[i] = heap[child];
+            heap_position[heap[i]] = i;
+            i = child;
+        }
+
+        heap[i] = var;
+        heap_position[var] = i;
+    }
+
+    void HeapInsert(int var)
+    {
+        heap.push_back(var);
+        HeapUp(heap.size() - 1);
+    }
+
+    int HeapPop()
+    {
+        int var = heap[0];
+
+        heap[0] = heap.back();
+        heap_position[heap[0]] = 0;
+        heap.pop_back();
+        heap_position[var] = -1;
+
+        if (!heap.empty())
+            HeapDown(0);
+
+        return var;
+    }
+
+    // Luby 序列: 1 1 2 1 1 2 4 ...
+    static long long Luby(long long x)
+    {
+        long long size = 1, seq = 0;
+
+        while (size < x + 1)
+        {
+            ++seq;
+            size = 2 * size + 1;
+        }
+
+        while (size - 1 != x)
+        {
+            size = (size - 1) >> 1;
+            --seq;
+            x = x % size;
+        }
+
+        return 1LL << seq;
+    }
+
+    // 子句是否为某个已赋值变元的原因子句
+    bool Locked(int c)
+    {
+        int literal = clause_db[c].literals[0];
+
+        return Value(literal) == 1 && reason[std::abs(literal)] == c;
+    }
+
+    // 删除子句, 单子句的赋值在第0层保留, 证明中不删除单子句
+    // 被删除的子句可能是第0层赋值的原因子句, 因此先把第0层赋值写入证明
+    void RemoveClause(int c)
+    {
+        if (proof && clause_db[c].literals.size() >= 2)
+        {
+            ProofRootUnits();
+            ProofDelete(clause_db[c].literals);
+        }
+
+        clause_db[c].removed = true;
+        clause_db[c].literals.clear();
+        clause_db[c].literals.shrink_to_fit();
+    }
+
+    // 删除一半 LBD 较大的学习子句
+    void ReduceLearnts()
+    {
+        std::vector<int> candidates;
+
+        for (size_t c = 0; c < clause_db.size(); ++c)
+        {
+            if (clause_db[c].learnt && !clause_db[c].removed && clause_db[c].lbd > 2 && !Locked(c))
+                candidates.push_back(c);
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            if (clause_db[a].lbd != clause_db[b].lbd)
+                return clause_db[a].lbd > clause_db[b].lbd;
+            return clause_db[a].literals.size() > clause_db[b].literals.size();
+        });
+
+        for (size_t i = 0; i < candidates.size() / 2; ++i)
+        {
+            RemoveClause(candidates[i]);
+        }
+    }
+
+    void ProofAdd(const std::vector<int> &literals)
+    {
+        if (proof)
+            proof->Add(literals);
+    }
+
+    void ProofDelete(const std::vector<int> &literals)
+    {
+        if (proof)
+            proof->Delete(literals);
+    }
+
+    // 把尚未写入证明的第0层赋值作为单子句写入, 之后删除它们的原因子句不影响证明检查
+    void ProofRootUnits()
+    {
+        if (!proof)
+            return;
+
+        size_t end = DecisionLevel() == 0 ? trail.size() : trail_lim[0];
+
+        for (; proof_units < end; ++proof_units)
+        {
+            proof->Add(std::vector<int>{trail[proof_units]});
+        }
+    }
+
+    // 输出一行进度, 深度为当前决策层, 子句数为未删除的原始子句与学习子句
+    void ReportProgress()
+    {
+        long long live = 0;
+
+        for (const auto &clause : clause_db)
+        {
+            if (!clause.removed)
+                ++live;
+        }
+
+        progress_reporter.Report(decisions, conflicts, DecisionLevel(), trail.size(), live);
+    }
+
+    // 主搜索循环
+    bool Search()
+    {
+        std::vector<int> learnt;
+
+        if (unsat)
+            return false;
+
+        if (Propagate() >= 0)
+        {
+            unsat = true;
+            return false;
+        }
+
+        while (true)
+        {
+            int conflict = Propagate();
+
+            if (conflict >= 0)
+            {
+                ++conflicts;
+
+                if (progress_counter)
+                    progress_counter->fetch_add(1, std::memory_order_relaxed);
+
+                if (progress_reporter.Due())
+                    ReportProgress();
+
+                if (cancel_flag && cancel_flag->load(std::memory_order_relaxed))
+                {
+                    cancelled = true;
+                    Backtrack(0);
+                    return false;
+                }
+
+                if (DecisionLevel() == 0)
+                {
+                    unsat = true;
+                    return false;
+                }
+
+                int backtrack_level;
+                Analyze(conflict, learnt, backtrack_level);
+                Backtrack(backtrack_level);
+                ++learned_clauses;
+                ProofAdd(learnt);
+
+                if (learnt.size() == 1)
+                {
+                    Enqueue(learnt[0], -1);
+                }
+                else
+                {
+                    int c = AttachClause(learnt, true, ComputeLbd(learnt));
+                    Enqueue(learnt[0], c);
+                }
+
+                var_inc /= 0.95;
+
+                if (conflicts >= next_reduce)
+                {
+                    next_reduce = conflicts + 2000 + 300 * (conflicts / 2000);
+                    ReduceLearnts();
+                }
+
+                // 重启
+                if (--restart_countdown <= 0)
+                {
+                    restart_countdown = 100 * Luby(++luby_index);
+                    Backtrack(0);
+                    ++restarts;
+
+                    if (inprocessing && conflicts >= next_inprocess && !Inprocess())
+                        return false;
+                }
+            }
+            else
+            {
+                int literal = PickBranchLiteral();
+
+                if (literal == 0)
+                {
+                    assignment_result.assign(BoolCount + 1, LiteralStatus::Unassigned);
+
+                    for (int var = 1; var <= BoolCount; ++var)
+                    {
+                        assignment_result[var] = (values[var] > 0 ? LiteralStatus::True : LiteralStatus::False);
+                    }
+
+                    return true;
+                }
+
+                ++decisions;
+                NewDecisionLevel();
+                Enqueue(literal, -1);
+
+                if (DecisionLevel() > max_level)
+                    max_level = DecisionLevel();
+            }
+        }
+    }
+
+    // 化简调度: 在第0层依次执行子句包含、失败文字试探与子句活化, 工作量与上一轮以来的搜索工作量成正比
+    bool Inprocess()
+    {
+        long long budget = std::max(10000LL, (long long)(inprocess_effort * (ticks - last_inprocess_ticks)));
+
+        ++inprocess_rounds;
+
+        if (!SimplifyAtRoot())
+            return false;
+
+        if (!Subsume(budget / 3) || !SimplifyAtRoot())
+            return false;
+
+        if (!Probe(budget / 3) || !SimplifyAtRoot())
+            return false;
+
+        if (!Vivify(budget / 3) || !SimplifyAtRoot())
+            return false;
+
+        next_inprocess = conflicts + inprocess_interval * (inprocess_rounds + 1);
+        last_inprocess_ticks = ticks;
+
+        return true;
+    }
+
+    // 第0层化简: 删除已满足的子句与已为假的文字, 然后重建监视表
+    bool SimplifyAtRoot()
+    {
+        while (true)
+        {
+            if (Propagate() >= 0)
+            {
+                unsat = true;
+                return false;
+            }
+
+            std::vector<int> units;
+
+            ProofRootUnits();
+
+            for (size_t c = 0; c < clause_db.size(); ++c)
+            {
+                Clause &clause = clause_db[c];
+
+                if (clause.removed)
+                    continue;
+
+                bool satisfied = false;
+                size_t j = 0;
+                std::vector<int> original;
+
+                if (proof)
+                    original = clause.literals;
+
+                for (size_t i = 0; i < clause.literals.size(); ++i)
+                {
+                    int value = Value(clause.literals[i]);
+
+                    if (value == 1)
+                    {
+                        satisfied = true;
+                        break;
+                    }
+
+                    if (value == 0)
+                        clause.literals[j++] = clause.literals[i];
+                }
+
+                if (satisfied)
+                {
+                    // 压缩过程中子句可能已被部分改写, 证明中删除原来的子句
+                    if (proof)
+                        clause.literals = original;
+
+                    RemoveClause(c);
+                    continue;
+                }
+
+                clause.literals.resize(j);
+
+                if (proof && j > 0 && j < original.size())
+                {
+                    ProofAdd(clause.literals);
+                    ProofDelete(original);
+                }
+
+                if (j == 0)
+                {
+                    unsat = true;
+                    return false;
+                }
+
+                if (j == 1)
+                {
+                    units.push_back(clause.literals[0]);
+                    RemoveClause(c);
+                }
+            }
+
+            RebuildWatches();
+
+            if (units.empty())
+                return true;
+
+            for (const auto literal : units)
+            {
+                if (Value(literal) == -1)
+                {
+                    unsat = true;
+                    return false;
+                }
+
+                if (Value(literal) == 0)
+                    Enqueue(literal, -1);
+            }
+        }
+    }
+
+    void RebuildWatches()
+    {
+        for (auto &list : watches)
+        {
+            list.clear();
+        }
+
+        for (size_t c = 0; c < clause_db.size(); ++c)
+        {
+            if (clause_db[c].removed)
+                continue;
+
+            watches[Code(clause_db[c].literals[0])].push_back(c);
+            watches[Code(clause_db[c].literals[1])].push_back(c);
+        }
+    }
+
+    // 子句包含与自包含消解, 对原始子句与学习子句一并进行
+    // 学习子句包含原始子句时把学习子句升级为原始子句
+    bool Subsume(long long budget)
+    {
+        std::vector<std::vector<int>> occurs(2 * BoolCount + 2);
+        std::vector<int> order;
+
+        for (size_t c = 0; c < clause_db.size(); ++c)
+        {
+            if (clause_db[c].removed)
+                continue;
+
+            order.push_back(c);
+
+            for (const auto literal : clause_db[c].literals)
+            {
+                occurs[Code(literal)].push_back(c);
+            }
+        }
+
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            return clause_db[a].literals.size() < clause_db[b].literals.size();
+        });
+
+        long long spent = 0;
+
+        for (const auto c : order)
+        {
+            if (spent > budget)
+                break;
+
+            // 空子句在循环之后统一处理
+            if (clause_db[c].removed || clause_db[c].literals.empty())
+                continue;
+
+            // 选择出现次数最少的文字, 候选子句必须含有该文字或其否定
+            int best = clause_db[c].literals[0];
+
+            for (const auto literal : clause_db[c].literals)
+            {
+                if (occurs[Code(literal)].size() + occurs[Code(-literal)].size() < occurs[Code(best)].size() + occurs[Code(-best)].size())
+                    best = literal;
+            }
+
+            for (const auto literal : clause_db[c].literals)
+            {
+                seen[std::abs(literal)] = (literal > 0 ? 1 : -1);
+            }
+
+            for (int sign = 0; sign < 2; ++sign)
+            {
+                for (const auto d : occurs[Code(sign ? -best : best)])
+                {
+                    if (d == c || clause_db[d].removed || clause_db[d].literals.size() < clause_db[c].literals.size())
+                        continue;
+
+                    spent += clause_db[d].literals.size();
+
+                    size_t matched = 0;
+                    int flipped = 0;
+
+                    for (const auto literal : clause_db[d].literals)
+                    {
+                        int mark = seen[std::abs(literal)];
+
+                        if (mark == 0)
+                            continue;
+
+                        ++matched;
+
+                        if (mark != (literal > 0 ? 1 : -1))
+                        {
+                            if (flipped != 0)
+                            {
+                                flipped = 0;
+                                matched = 0;
+                                break;
+                            }
+
+                            flipped = literal;
+                        }
+                    }
+
+                    if (matched != clause_db[c].literals.size())
+                        continue;
+
+                    if (flipped == 0)
+                    {
+                        // c 包含 d
+                        if (clause_db[c].learnt && !clause_db[d].learnt)
+                            clause_db[c].learnt = false;
+
+                        RemoveClause(d);
+                    }
+                    else
+                    {
+                        // 自包含消解: 从 d 中删去 flipped
+                        std::vector<int> &literals = clause_db[d].literals;
+                        std::vector<int> original;
+
+                        if (proof)
+                            original = literals;
+
+                        literals.erase(std::find(literals.begin(), literals.end(), flipped));
+
+                        if (proof)
+                        {
+                            ProofAdd(literals);
+                            ProofDelete(original);
+                        }
+
+                        // d 被化简为空子句, 公式无解
+                        if (literals.empty())
+                        {
+                            for (const auto literal : clause_db[c].literals)
+                            {
+                                seen[std::abs(literal)] = 0;
+                            }
+
+                            unsat = true;
+                            return false;
+                        }
+                    }
+                }
+            }
+
+            for (const auto literal : clause_db[c].literals)
+            {
+                seen[std::abs(literal)] = 0;
+            }
+        }
+
+        // 被删去文字的子句可能变为单子句(或空子句), 单子句的赋值由 SimplifyAtRoot 传播
+        for (size_t c = 0; c < clause_db.size(); ++c)
+        {
+            if (!clause_db[c].removed && clause_db[c].literals.empty())
+            {
+                unsat = true;
+                return false;
+            }
+
+            if (!clause_db[c].removed && clause_db[c].literals.size() == 1)
+            {
+                int literal = clause_db[c].literals[0];
+                RemoveClause(c);
+
+                if (Value(literal) == -1)
+                {
+                    unsat = true;
+                    return false;
+                }
+
+                if (Value(literal) == 0)
+                    Enqueue(literal, -1);
+            }
+        }
+
+        // 自包含消解删去的文字可能是监视文字, 在传播新的单子句之前重建监视表
+        RebuildWatches();
+
+        return true;
+    }
+
+    // 失败文字试探: 用求解器自身的传播在第1层试探文字, 产生冲突则其否定在第0层成立
+    bool Probe(long long budget)
+    {
+        // 只试探能通过二元子句蕴含其他文字的文字
+        std::vector<bool> has_implication(2 * BoolCount + 2, false);
+
+        for (const auto &clause : clause_db)
+        {
+            if (!clause.removed && clause.literals.size() == 2)
+            {
+                has_implication[Code(-clause.literals[0])] = true;
+                has_implication[Code(-clause.literals[1])] = true;
+            }
+        }
+
+        long long start = ticks;
+
+        for (int count = 0; count < BoolCount && ticks - start < budget; ++count)
+        {
+            int var = probe_next;
+            probe_next = (probe_next % BoolCount) + 1;
+
+            for (int sign = 0; sign < 2; ++sign)
+            {
+                int literal = sign ? -var : var;
+
+                if (values[var] != 0 || !has_implication[Code(literal)])
+                    continue;
+
+                NewDecisionLevel();
+                Enqueue(literal, -1);
+                bool failed = Propagate() >= 0;
+                Backtrack(0);
+
+                if (!failed)
+                    continue;
+
+                ProofAdd(std::vector<int>{-literal});
+                Enqueue(-literal, -1);
+
+                if (Propagate() >= 0)
+                {
+                    unsat = true;
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // 子句活化: 依次假设子句中文字的否定并传播
+    // 某文字被蕴含为假则删去该文字, 被蕴含为真或出现冲突则截断子句
+    // 活化时子句本身暂时不参与传播, 优先处理 LBD 小的学习子句
+    bool Vivify(long long budget)
+    {
+        std::vector<int> candidates;
+
+        for (int pass = 0; pass < 2 && candidates.empty(); ++pass)
+        {
+            for (size_t c = 0; c < clause_db.size(); ++c)
+            {
+                Clause &clause = clause_db[c];
+
+                if (clause.removed || clause.literals.size() < 3)
+                    continue;
+
+                // 所有子句都活化过一遍后重新开始
+                if (pass == 1)
+                    clause.vivified = false;
+
+                if (!clause.vivified)
+                    candidates.push_back(c);
+            }
+        }
+
+        std::stable_sort(candidates.begin(), candidates.end(), [this](int a, int b) {
+            if (clause_db[a].learnt != clause_db[b].learnt)
+                return clause_db[a].learnt;
+            return clause_db[a].lbd < clause_db[b].lbd;
+        });
+
+        long long start = ticks;
+
+        for (const auto c : candidates)
+        {
+            if (ticks - start >= budget)
+                break;
+
+            if (clause_db[c].removed)
+                continue;
+
+            clause_db[c].vivified = true;
+
+            if (!VivifyClause(c))
+                return false;
+        }
+
+        return true;
+    }
+
+    void DetachClause(int c)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            std::vector<int> &list = watches[Code(clause_db[c].literals[i])];
+            list.erase(std::find(list.begin(), list.end(), c));
+        }
+    }
+
+    bool VivifyClause(int c)
+    {
+        std::vector<int> literals = clause_db[c].literals;
+        std::vector<int> kept;
+
+        // 暂时把子句移出监视表
+        DetachClause(c);
+
+        NewDecisionLevel();
+
+        for (const auto literal : literals)
+        {
+            int value = Value(literal);
+
+            if (value == 1)
+            {
+                kept.push_back(literal);
+                break;
+            }
+
+            if (value == -1)
+                continue;
+
+            kept.push_back(literal);
+            Enqueue(-literal, -1);
+
+            if (Propagate() >= 0)
+                break;
+        }
+
+        Backtrack(0);
+
+        // 去掉第0层为假的文字
+        bool satisfied = false;
+        size_t j = 0;
+
+        for (size_t i = 0; i < kept.size(); ++i)
+        {
+            int value = Value(kept[i]);
+
+            if (value == 1)
+                satisfied = true;
+            else if (value == 0)
+                kept[j++] = kept[i];
+        }
+
+        kept.resize(j);
+
+        Clause &clause = clause_db[c];
+
+        if (satisfied)
+        {
+            RemoveClause(c);
+            return true;
+        }
+
+        vivified_literals += literals.size() - kept.size();
+
+        if (kept.empty())
+        {
+            unsat = true;
+            return false;
+        }
+
+        if (kept.size() < literals.size())
+            ProofAdd(kept);
+
+        if (kept.size() == 1)
+        {
+            RemoveClause(c);
+            Enqueue(kept[0], -1);
+
+            if (Propagate() >= 0)
+            {
+                unsat = true;
+                return false;
+            }
+
+            return true;
+        }
+
+        if (kept.size() < literals.size())
+            ProofDelete(literals);
+
+        clause.literals = kept;
+        watches[Code(kept[0])].push_back(c);
+        watches[Code(kept[1])].push_back(c);
+
+        return true;
+    }
+};
+
+#endif
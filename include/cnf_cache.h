@@ -0,0 +1,419 @@
+#ifndef CNF_CACHE_H
+#define CNF_CACHE_H
+
+#include "cnf_parser.h"
+#include "list.h"
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 只读方式把整个文件映射到内存
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile()
+    {
+        Close();
+    }
+
+    bool Open(const std::string &filename)
+    {
+        Close();
+
+#ifdef _WIN32
+        file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER file_size;
+
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (!mapping)
+        {
+            Close();
+            return false;
+        }
+
+        data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        size = (size_t)file_size.QuadPart;
+#else
+        fd = open(filename.c_str(), O_RDONLY);
+
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            Close();
+            return false;
+        }
+
+        void *address = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (address == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+
+        data = (const unsigned char *)address;
+        size = (size_t)st.st_size;
+#endif
+
+        if (!data)
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Close()
+    {
+#ifdef _WIN32
+        if (data)
+            UnmapViewOfFile(data);
+
+        if (mapping)
+            CloseHandle(mapping);
+
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data)
+            munmap((void *)data, size);
+
+        if (fd >= 0)
+            close(fd);
+
+        fd = -1;
+#endif
+
+        data = nullptr;
+        size = 0;
+    }
+
+    const unsigned char *Data() const
+    {
+        return data;
+    }
+
+    size_t Size() const
+    {
+        return size;
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+};
+
+// 解析后的子句集合的二进制缓存, 文件名为 cnf 文件名后加 .bin
+// 第一次读取 cnf 文件时写出, 之后只要 cnf 文件的大小与修改时间未变就直接映射缓存读取, 跳过文本解析
+// 文件头 64 字节(小端): 标识 "SATCNFB2", cnf 文件大小, cnf 文件修改时间, 变元数, 子句数(p 行), 子句条数, 数据长度, 校验和, 保留
+// 数据部分每个子句为 varint(文字数) 与各文字的 zigzag varint, 校验和为文件头前 48 字节与数据部分的 64 位 FNV-1a
+class CNFCache
+{
+public:
+    static std::string FileName(const std::string &filename)
+    {
+        return filename + ".bin";
+    }
+
+    // 读取缓存, 缓存不存在、已过期或损坏时返回false, 此时 clauses 不变
+    static bool Load(const std::string &filename, DeLinkList<cnf_parser::clause> &clauses, int &BoolCount, int &ClauseCount)
+    {
+        unsigned long long source_size;
+        long long source_time;
+
+        if (!SourceInfo(filename, source_size, source_time))
+            return false;
+
+        MappedFile file;
+
+        if (!file.Open(FileName(filename)) || file.Size() < HeaderSize)
+            return false;
+
+        const unsigned char *data = file.Data();
+
+        if (memcmp(data, Magic, 8) != 0 || ReadU64(data + 8) != source_size || (long long)ReadU64(data + 16) != source_time)
+            return false;
+
+        unsigned long long bool_count = ReadU32(data + 24);
+        unsigned long long clause_count = ReadU32(data + 28);
+        unsigned long long records = ReadU64(data + 32);
+        unsigned long long payload_size = ReadU64(data + 40);
+
+        if (bool_count > INT_MAX || clause_count > INT_MAX || payload_size != file.Size() - HeaderSize)
+            return false;
+
+        if (Checksum(data + HeaderSize, payload_size, Checksum(data, 48)) != ReadU64(data + 48))
+            return false;
+
+        // 先解码到局部链表, 全部通过检查后再加入 clauses
+        DeLinkList<cnf_parser::clause> loaded;
+        const unsigned char *it = data + HeaderSize;
+        const unsigned char *end = it + payload_size;
+
+        for (unsigned long long added = 0; added < records; ++added)
+        {
+            unsigned long long length;
+
+            if (!ReadVarint(it, end, length))
+                return false;
+
+            cnf_parser::clause clause;
+
+            for (unsigned long long i = 0; i < length; ++i)
+            {
+                unsigned long long code;
+
+                if (!ReadVarint(it, end, code))
+                    return false;
+
+                // zigzag 解码, 文字必须非零且不超过变元数
+                unsigned long long variable = (code >> 1) + (code & 1);
+
+                if (variable == 0 || variable > bool_count)
+                    return false;
+
+                clause.literals.push_back((code & 1) ? -(int)variable : (int)variable);
+            }
+
+            loaded.push_back(clause);
+        }
+
+        if (it != end)
+            return false;
+
+        for (auto it_clause = loaded.begin(); it_clause != loaded.end(); ++it_clause)
+        {
+            clauses.push_back(*it_clause);
+        }
+
+        BoolCount = (int)bool_count;
+        ClauseCount = (int)clause_count;
+
+        return true;
+    }
+
+    // 写出缓存, 先写临时文件再改名, 避免留下不完整的缓存
+    static bool Save(const std::string &filename, DeLinkList<cnf_parser::clause> &clauses, int BoolCount, int ClauseCount)
+    {
+        unsigned long long source_size;
+        long long source_time;
+
+        if (!SourceInfo(filename, source_size, source_time))
+            return false;
+
+        std::vector<unsigned char> buffer(HeaderSize);
+        unsigned long long records = 0;
+
+        for (auto it_clause = clauses.begin(); it_clause != clauses.end(); ++it_clause)
+        {
+            WriteVarint(buffer, (*it_clause).literals.size());
+
+            for (auto it_literal = (*it_clause).literals.begin(); it_literal != (*it_clause).literals.end(); ++it_literal)
+            {
+                long long literal = *it_literal;
+
+                // zigzag 编码, 使绝对值小的负数也只占很少的字节
+                WriteVarint(buffer, ((unsigned long long)literal << 1) ^ (unsigned long long)(literal >> 63));
+            }
+
+            ++records;
+        }
+
+        unsigned long long payload_size = buffer.size() - HeaderSize;
+
+        memcpy(buffer.data(), Magic, 8);
+        WriteU64(buffer.data() + 8, source_size);
+        WriteU64(buffer.data() + 16, (unsigned long long)source_time);
+        WriteU32(buffer.data() + 24, (unsigned)BoolCount);
+        WriteU32(buffer.data() + 28, (unsigned)ClauseCount);
+        WriteU64(buffer.data() + 32, records);
+        WriteU64(buffer.data() + 40, payload_size);
+        WriteU64(buffer.data() + 48, Checksum(buffer.data() + HeaderSize, payload_size, Checksum(buffer.data(), 48)));
+        WriteU64(buffer.data() + 56, 0);
+
+        std::string temp = FileName(filename) + ".tmp";
+
+        {
+            std::ofstream outFile(temp, std::ios::binary);
+
+            if (!outFile)
+                return false;
+
+            outFile.write((const char *)buffer.data(), buffer.size());
+
+            if (!outFile)
+            {
+                outFile.close();
+                std::error_code ec;
+                std::filesystem::remove(temp, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(temp, FileName(filename), ec);
+
+        if (ec)
+        {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    static constexpr const char *Magic = "SATCNFB2";
+    static const size_t HeaderSize = 64;
+
+    // cnf 文件的大小与修改时间, 用于判断缓存是否过期
+    static bool SourceInfo(const std::string &filename, unsigned long long &size, long long &time)
+    {
+        std::error_code ec;
+
+        size = std::filesystem::file_size(filename, ec);
+
+        if (ec)
+            return false;
+
+        auto write_time = std::filesystem::last_write_time(filename, ec);
+
+        if (ec)
+            return false;
+
+        time = (long long)write_time.time_since_epoch().count();
+
+        return true;
+    }
+
+    // 64 位 FNV-1a, hash 为之前已计算部分的结果, 用于分段计算
+    static unsigned long long Checksum(const unsigned char *data, size_t size, unsigned long long hash = 14695981039346656037ULL)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    static void WriteVarint(std::vector<unsigned char> &buffer, unsigned long long value)
+    {
+        while (value >= 0x80)
+        {
+            buffer.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
+        }
+
+        buffer.push_back((unsigned char)value);
+    }
+
+    static bool ReadVarint(const unsigned char *&it, const unsigned char *end, unsigned long long &value)
+    {
+        value = 0;
+
+        for (int shift = 0; it != end && shift < 64; shift += 7)
+        {
+            unsigned char byte = *it++;
+
+            value |= (unsigned long long)(byte & 0x7f) << shift;
+
+            if (!(byte & 0x80))
+                return true;
+        }
+
+        return false;
+    }
+
+    static void WriteU32(unsigned char *out, unsigned value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = (unsigned char)(value >> (8 * i));
+        }
+    }
+
+    static void WriteU64(unsigned char *out, unsigned long long value)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            out[i] = (unsigned char)(value >> (8 * i));
+        }
+    }
+
+    static unsigned ReadU32(const unsigned char *in)
+    {
+        unsigned value = 0;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= (unsigned)in[i] << (8 * i);
+        }
+
+        return value;
+    }
+
+    static unsigned long long ReadU64(const unsigned char *in)
+    {
+        unsigned long long value = 0;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            value |= (unsigned long long)in[i] << (8 * i);
+        }
+
+        return value;
+    }
+};
+
+#endif
@@ -25,13 +25,30 @@ public:
     };
     
     // 读取cnf文件
+    // 开启二进制缓存时优先读取 filename.bin, 缓存不存在或已过期时解析文本并写出缓存
     bool ReadCNFFile(const std::string filename, DeLinkList<clause> &clauses);
 
+    // 开启或关闭二进制缓存(默认开启)
+    void SetBinaryCache(bool enable)
+    {
+        this->binary_cache = enable;
+    }
+
+    // 上一次读取是否来自二进制缓存
+    bool IsLoadedFromCache() const
+    {
+        return this->loaded_from_cache;
+    }
+
     // 判断是否为单子句（只有一个文字）
     bool IsUnitClause(clause clause);
 
     // 输出res文件
-    void WriteRes(std::vector<LiteralStatus> assignemnt, std::string filename, bool flag, long long runtime, std::vector<size_t> left_nums);
+    void WriteRes(const std::vector<LiteralStatus> &assignment, const std::string &filename, bool flag, long long runtime, const std::vector<size_t> &left_nums);
+
+private:
+    bool binary_cache = true;
+    bool loaded_from_cache = false;
 };
 
 #endif
\ No newline at end of file
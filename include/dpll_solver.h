@@ -4,6 +4,12 @@
 #include "cnf_parser.h"
 #include "utils.h"
 #include "list.h"
+#include "preprocessor.h"
+#include "cdcl_solver.h"
+#include "solver_stats.h"
+#include "trace.h"
+#include "progress_reporter.h"
+#include "model_checker.h"
 #include <chrono>
 #include <iostream>
 #include <vector>
@@ -17,29 +23,143 @@ std::atomic<bool> cancelFlag(false);
 class DPLLSolver
 {
 public:
-    DPLLSolver() : flag(false) {}
+    DPLLSolver() : flag(false), preprocessing(false), verify_model(true), model_valid(true), cancelled(false), cancel_flag(nullptr), progress_counter(nullptr), depth(0) {}
 
     bool BasicSolve(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
     {
+        if (!Preprocess(clauses, BoolCount))
+            return Reconstruct(false);
+
         LiteralStatus assignment[BoolCount + 1] = {LiteralStatus::Unassigned};
 
-        return BasicSolveRecursively(clauses, assignment, BoolCount);
+        return Reconstruct(BasicSolveRecursively(clauses, assignment, BoolCount));
     }
 
     bool OptimizedSolve1(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
     {
+        if (!Preprocess(clauses, BoolCount))
+            return Reconstruct(false);
+
         LiteralStatus assignment[BoolCount + 1] = {LiteralStatus::Unassigned};
 
-        return OptimizedSolveRecursively1(clauses, assignment, BoolCount);
+        return Reconstruct(OptimizedSolveRecursively1(clauses, assignment, BoolCount));
     }
 
     bool OptimizedSolve2(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
     {
+        if (!Preprocess(clauses, BoolCount))
+            return Reconstruct(false);
+
         LiteralStatus assignment[BoolCount + 1] = {LiteralStatus::Unassigned};
 
         this->threshold = clauses.size() >> 1;
 
-        return OptimizedSolveRecursively2(clauses, assignment, BoolCount);
+        return Reconstruct(OptimizedSolveRecursively2(clauses, assignment, BoolCount));
+    }
+
+    // 优化后的求解器3: CDCL
+    bool OptimizedSolve3(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        if (!Preprocess(clauses, BoolCount))
+            return Reconstruct(false);
+
+        bool result = cdcl_solver.Solve(clauses, BoolCount);
+
+        this->cancelled = cdcl_solver.WasCancelled();
+
+        stats.decisions = cdcl_solver.GetDecisions();
+        stats.propagations = cdcl_solver.GetPropagations();
+        stats.conflicts = cdcl_solver.GetConflicts();
+        stats.restarts = cdcl_solver.GetRestarts();
+        stats.learned_clauses = cdcl_solver.GetLearnedClauses();
+        stats.max_depth = cdcl_solver.GetMaxLevel();
+
+        if (result)
+            this->assignment_result = cdcl_solver.GetAssignment();
+
+        return Reconstruct(result);
+    }
+
+    // 统计模型数量, 找到 limit 个后停止, 用 CDCL 求解器加阻塞子句枚举
+    // 变元消去不保持模型数量, 因此计数时不做预处理
+    long long CountSolutions(DeLinkList<cnf_parser::clause> &clauses, int BoolCount, long long limit)
+    {
+        long long count = cdcl_solver.CountSolutions(clauses, BoolCount, limit);
+
+        if (count > 0)
+            this->assignment_result = cdcl_solver.GetAssignment();
+
+        return count;
+    }
+
+    // 设置取消标志, 标志被置为true后搜索尽快返回false(结果不可信)
+    void SetCancelFlag(std::atomic<bool> *cancel_flag)
+    {
+        this->cancel_flag = cancel_flag;
+        cdcl_solver.SetCancelFlag(cancel_flag);
+    }
+
+    // 设置进度计数器, DPLL每访问一个搜索结点(CDCL每发生一次冲突)加一, 可由其他线程读取
+    void SetProgressCounter(std::atomic<long long> *progress_counter)
+    {
+        this->progress_counter = progress_counter;
+        cdcl_solver.SetProgressCounter(progress_counter);
+    }
+
+    // 设置进度输出间隔(秒), 不大于0时关闭, 求解时按间隔向 out 输出一行进度
+    void SetProgressInterval(double interval, std::ostream *out = &std::cout)
+    {
+        progress_reporter.SetInterval(interval, out);
+        cdcl_solver.SetProgressInterval(interval, out);
+    }
+
+    bool IsCancelled() const
+    {
+        return this->cancel_flag && this->cancel_flag->load(std::memory_order_relaxed);
+    }
+
+    // 上一次求解是否因取消标志而提前返回; 求解结束后标志才被置位时仍为false, 结果可信
+    bool WasCancelled() const
+    {
+        return this->cancelled;
+    }
+
+    CDCLSolver &GetCDCLSolver()
+    {
+        return this->cdcl_solver;
+    }
+
+    // 开启或关闭求解前的预处理
+    void SetPreprocessing(bool enable)
+    {
+        this->preprocessing = enable;
+    }
+
+    bool IsPreprocessing() const
+    {
+        return this->preprocessing;
+    }
+
+    // 开启或关闭求解后对解的检查(默认开启)
+    void SetVerifyModel(bool enable)
+    {
+        this->verify_model = enable;
+    }
+
+    // 上一次求解给出的解是否通过检查, 未开启检查或无解时为true
+    bool IsModelValid() const
+    {
+        return this->model_valid;
+    }
+
+    Preprocessor &GetPreprocessor()
+    {
+        return this->preprocessor;
+    }
+
+    const Preprocessor &GetPreprocessor() const
+    {
+        return this->preprocessor;
     }
 
     std::vector<LiteralStatus> GetAssignment()
@@ -52,18 +172,147 @@ public:
         return this->left_nums;
     }
 
+    // 上一次求解的统计信息, CDCL 求解时的计数取自 CDCL 求解器
+    const SolverStats &GetStats() const
+    {
+        return this->stats;
+    }
+
+    long long GetDecisions() const
+    {
+        return this->stats.decisions;
+    }
+
+    long long GetPropagations() const
+    {
+        return this->stats.propagations;
+    }
+
 private:
+    // 微基准测试直接调用单子句传播与分裂策略
+    friend class DPLLKernels;
+
     bool flag;
+    bool preprocessing;
+    bool verify_model;
+    bool model_valid;
+    bool cancelled;
     int threshold;
+    Preprocessor preprocessor;
+    CDCLSolver cdcl_solver;
+    ModelChecker model_checker;
+    std::atomic<bool> *cancel_flag;
+    std::atomic<long long> *progress_counter;
+    ProgressReporter progress_reporter;
+    SolverStats stats;
+    long long depth;                                        // 当前递归深度
+    std::chrono::high_resolution_clock::time_point search_start;
     std::string filename;
     std::vector<LiteralStatus> assignment_result;
-    std::vector<size_t> left_nums;
+    std::vector<size_t> left_nums;                          // 叶结点上剩余的子句数, 只保留前 MaxLeftNums 个
     typedef std::pair<int, int> PII;
 
+    static const size_t MaxLeftNums = 1000;
+
+    // 记录叶结点, left 为剩余的子句数
+    void RecordLeaf(size_t left)
+    {
+        stats.RecordLeaf(left);
+
+        if (left_nums.size() < MaxLeftNums)
+            left_nums.push_back(left);
+    }
+
+    // 进入一个搜索结点时记录深度, 离开时恢复
+    struct DepthGuard
+    {
+        DPLLSolver *solver;
+
+        explicit DepthGuard(DPLLSolver *solver) : solver(solver)
+        {
+            if (++solver->depth > solver->stats.max_depth)
+                solver->stats.max_depth = solver->depth;
+        }
+
+        ~DepthGuard()
+        {
+            --solver->depth;
+        }
+    };
+
+    // 访问一个搜索结点: 更新进度计数器, 到时间时输出进度, 并检查是否被取消
+    // 赋值数组在回溯时不清空, 因此进度中只输出递归深度, 不输出已赋值文字数
+    bool Interrupted(const DeLinkList<cnf_parser::clause> &clauses)
+    {
+        if (this->progress_counter)
+            this->progress_counter->fetch_add(1, std::memory_order_relaxed);
+
+        if (progress_reporter.Due())
+            progress_reporter.Report(stats.decisions, stats.conflicts, depth, -1, clauses.size());
+
+        if (IsCancelled())
+            this->cancelled = true;
+
+        return this->cancelled;
+    }
+
+    // 预处理, BoolCount 被更新为化简后的变元数量, 返回false表示子句集合已被化简为无解
+    // 同时清空上一次求解的统计信息
+    bool Preprocess(DeLinkList<cnf_parser::clause> &clauses, int &BoolCount)
+    {
+        stats.Reset();
+        stats.variables = BoolCount;
+        stats.clauses = clauses.size();
+        left_nums.clear();
+        depth = 0;
+        model_valid = true;
+        cancelled = false;
+
+        // 求解会修改子句集合, 检查解需要的原公式在此之前复制
+        if (verify_model)
+            model_checker.Snapshot(clauses, BoolCount);
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        bool result;
+
+        {
+            TraceScope trace(TracePhase::Preprocess);
+            result = !this->preprocessing || preprocessor.Simplify(clauses, BoolCount);
+        }
+
+        search_start = std::chrono::high_resolution_clock::now();
+        progress_reporter.Start();
+        stats.preprocess_ms = std::chrono::duration<double, std::milli>(search_start - start_time).count();
+
+        return result;
+    }
+
+    // 有解时把化简后公式的模型还原为原公式的完整模型并检查, 并记录搜索时间、检查时间与内存峰值
+    bool Reconstruct(bool result)
+    {
+        if (result && this->preprocessing)
+            preprocessor.ExtendAssignment(this->assignment_result);
+
+        auto verify_start = std::chrono::high_resolution_clock::now();
+
+        if (result && verify_model)
+            model_valid = model_checker.Check(this->assignment_result);
+
+        stats.result = result;
+        stats.search_ms = std::chrono::duration<double, std::milli>(verify_start - search_start).count();
+        stats.verify_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - verify_start).count();
+        stats.model_valid = model_valid;
+        stats.peak_memory_kb = SolverStats::PeakMemoryKB();
+
+        return result;
+    }
+
     // 基础分裂策略选择器
     // 选择出现次数最多的未赋值的文字作为分裂的变元
     int SelectLiteral(const PII counter[], const int BoolCount)
     {
+        TraceScope trace(TracePhase::Branch);
+
         int max_occurence = 0;
         int select_literal = 0;
 
@@ -83,6 +332,8 @@ private:
     // MOM分裂策略
     int Branching(int min_size, DeLinkList<cnf_parser::clause> &clauses, const int BoolCount)
     {
+        TraceScope trace(TracePhase::Branch);
+
         // 统计出现次数
         PII counter[BoolCount + 1] = {{0, 0}};
 
@@ -115,6 +366,8 @@ private:
     // 单子句传播
     void UnitClausePropagation(DeLinkList<cnf_parser::clause> &clauses, LiteralStatus assigenment[])
     {
+        TraceScope trace(TracePhase::Propagate);
+
         cnf_parser parser;
 
         while (true)
@@ -138,6 +391,8 @@ private:
             if (!HaveUnitClause)
                 return;
 
+            stats.propagations += UnitLiterals.size();
+
             // 化简子句集合
             for (const auto UnitLiteral : UnitLiterals)
             {
@@ -196,6 +451,12 @@ private:
     // 基础DPLL求解器
     bool BasicSolveRecursively(DeLinkList<cnf_parser::clause> &clauses, LiteralStatus assignment[], const int BoolCount)
     {
+        // 记录进度, 被取消时直接返回
+        if (Interrupted(clauses))
+            return false;
+
+        DepthGuard guard(this);
+
         // 单子句传播
         UnitClausePropagation(clauses, assignment);
 
@@ -218,7 +479,7 @@ private:
         if (clauses.empty())
         {
             this->assignment_result = std::vector<LiteralStatus>(assignment, assignment + BoolCount + 1);
-            left_nums.push_back(0);
+            RecordLeaf(0);
             return true;
         }
 
@@ -227,7 +488,7 @@ private:
         {
             if ((*it_clause).literals.empty())
             {
-                left_nums.push_back(clauses.size());
+                RecordLeaf(clauses.size());
                 return false;
             }
         }
@@ -235,6 +496,8 @@ private:
         // 分裂策略
         int select_literal = SelectLiteral(counter, BoolCount);
 
+        ++stats.decisions;
+
         // 构建搜索副本
         DeLinkList<cnf_parser::clause> clauses_tmp = clauses;
 
@@ -257,6 +520,12 @@ private:
     // 优化后的DPLL求解器1
     bool OptimizedSolveRecursively1(DeLinkList<cnf_parser::clause> &clauses, LiteralStatus assignment[],const int BoolCount)
     {
+        // 记录进度, 被取消时直接返回
+        if (Interrupted(clauses))
+            return false;
+
+        DepthGuard guard(this);
+
         // 单子句传播
         UnitClausePropagation(clauses, assignment);
 
@@ -279,7 +548,7 @@ private:
         if (clauses.empty())
         {
             this->assignment_result = std::vector<LiteralStatus>(assignment, assignment + BoolCount + 1);
-            left_nums.push_back(0);
+            RecordLeaf(0);
             return true;
         }
 
@@ -291,7 +560,7 @@ private:
         {
             if ((*it_clause).literals.empty())
             {
-                left_nums.push_back(clauses.size());
+                RecordLeaf(clauses.size());
                 return false;
             }
 
@@ -303,6 +572,8 @@ private:
   
         select_literal = Branching(min_size, clauses, BoolCount);
 
+        ++stats.decisions;
+
         // 构建搜索副本
         DeLinkList<cnf_parser::clause> clauses_tmp = clauses;
 
@@ -325,6 +596,12 @@ private:
     // 优化后的DPLL求解器2
     bool OptimizedSolveRecursively2(DeLinkList<cnf_parser::clause> &clauses, LiteralStatus assignment[],const int BoolCount)
     {
+        // 记录进度, 被取消时直接返回
+        if (Interrupted(clauses))
+            return false;
+
+        DepthGuard guard(this);
+
         // 单子句传播
         UnitClausePropagation(clauses, assignment);
 
@@ -347,7 +624,7 @@ private:
         if (clauses.empty())
         {
             this->assignment_result = std::vector<LiteralStatus>(assignment, assignment + BoolCount + 1);
-            left_nums.push_back(0);
+            RecordLeaf(0);
             return true;
         }
 
@@ -359,7 +636,7 @@ private:
         {
             if ((*it_clause).literals.empty())
             {
-                left_nums.push_back(clauses.size());
+                RecordLeaf(clauses.size());
                 return false;
             }
 
@@ -377,6 +654,8 @@ private:
             select_literal = Branching(min_size, clauses, BoolCount);
         }
 
+        ++stats.decisions;
+
         // 构建搜索副本
         DeLinkList<cnf_parser::clause> clauses_tmp = clauses;
 
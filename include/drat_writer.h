@@ -0,0 +1,230 @@
+#ifndef DRAT_WRITER_H
+#define DRAT_WRITER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// DRAT 证明输出, 供 drat-trim 等检查器验证无解的结论
+// 求解线程只把子句编码进内存缓冲区, 缓冲区满 ChunkSize 后交给独立的写线程写入文件, 写线程落后太多时求解线程等待
+// 二进制格式: 加入子句为 'a', 删除子句为 'd', 之后每个文字 l 编码为 2*|l| + (l < 0) 的 varint, 以 0 结尾
+// 文本格式: 每行一个子句, 删除的子句以 "d " 开头, 以 0 结尾
+class DRATWriter
+{
+public:
+    DRATWriter() = default;
+    DRATWriter(const DRATWriter &) = delete;
+    DRATWriter &operator=(const DRATWriter &) = delete;
+
+    ~DRATWriter()
+    {
+        Close();
+    }
+
+    bool Open(const std::string &filename, bool binary = true)
+    {
+        Close();
+
+        file = fopen(filename.c_str(), binary ? "wb" : "w");
+
+        if (!file)
+        {
+            std::cerr << "证明文件打开失败: " << filename << std::endl;
+            return false;
+        }
+
+        this->binary = binary;
+        failed = false;
+        stopping = false;
+        bytes = 0;
+        buffer.clear();
+        buffer.reserve(ChunkSize + 4096);
+
+        writer = std::thread(&DRATWriter::WriterLoop, this);
+
+        return true;
+    }
+
+    bool IsOpen() const
+    {
+        return file != nullptr;
+    }
+
+    template <typename Literals>
+    void Add(const Literals &literals)
+    {
+        Write('a', literals);
+    }
+
+    template <typename Literals>
+    void Delete(const Literals &literals)
+    {
+        Write('d', literals);
+    }
+
+    // 写出剩余内容并关闭文件, 返回false表示写入过程中出错
+    bool Close()
+    {
+        if (!file)
+            return true;
+
+        Submit();
+
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            stopping = true;
+        }
+
+        queue_cv.notify_all();
+        writer.join();
+
+        if (fclose(file) != 0)
+            failed = true;
+
+        file = nullptr;
+
+        if (failed)
+            std::cerr << "证明文件写入失败" << std::endl;
+
+        return !failed;
+    }
+
+    // 已写入(或已交给写线程)的字节数
+    long long GetBytes() const
+    {
+        return bytes + (long long)buffer.size();
+    }
+
+private:
+    static const size_t ChunkSize = 1 << 20;   // 每块缓冲区的大小
+    static const size_t MaxPending = 8;        // 等待写入的缓冲区块数上限
+
+    FILE *file = nullptr;
+    bool binary = true;
+    bool failed = false;
+    bool stopping = false;
+    long long bytes = 0;
+    std::vector<char> buffer;                  // 求解线程正在填充的缓冲区
+    std::deque<std::vector<char>> pending;     // 等待写线程写入的缓冲区
+    std::vector<std::vector<char>> spare;      // 写完后回收的缓冲区
+    std::mutex mtx;
+    std::condition_variable queue_cv;          // 有新的缓冲区或需要结束
+    std::condition_variable space_cv;          // 等待队列有空位
+    std::thread writer;
+
+    template <typename Literals>
+    void Write(char type, const Literals &literals)
+    {
+        if (!file)
+            return;
+
+        if (binary)
+        {
+            buffer.push_back(type);
+
+            for (const auto literal : literals)
+            {
+                unsigned value = 2u * (unsigned)std::abs(literal) + (literal < 0);
+
+                while (value >= 0x80)
+                {
+                    buffer.push_back((char)(value | 0x80));
+                    value >>= 7;
+                }
+
+                buffer.push_back((char)value);
+            }
+
+            buffer.push_back(0);
+        }
+        else
+        {
+            char number[16];
+
+            if (type == 'd')
+            {
+                buffer.push_back('d');
+                buffer.push_back(' ');
+            }
+
+            for (const auto literal : literals)
+            {
+                int length = snprintf(number, sizeof(number), "%d ", (int)literal);
+                buffer.insert(buffer.end(), number, number + length);
+            }
+
+            buffer.push_back('0');
+            buffer.push_back('\n');
+        }
+
+        if (buffer.size() >= ChunkSize)
+            Submit();
+    }
+
+    // 把当前缓冲区交给写线程, 换一块空的缓冲区继续填充
+    void Submit()
+    {
+        if (buffer.empty())
+            return;
+
+        std::unique_lock<std::mutex> lock(mtx);
+
+        space_cv.wait(lock, [this]() { return pending.size() < MaxPending; });
+
+        bytes += buffer.size();
+        pending.push_back(std::move(buffer));
+
+        if (!spare.empty())
+        {
+            buffer = std::move(spare.back());
+            spare.pop_back();
+        }
+        else
+        {
+            buffer = std::vector<char>();
+            buffer.reserve(ChunkSize + 4096);
+        }
+
+        buffer.clear();
+
+        lock.unlock();
+        queue_cv.notify_one();
+    }
+
+    void WriterLoop()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+
+        while (true)
+        {
+            queue_cv.wait(lock, [this]() { return stopping || !pending.empty(); });
+
+            if (pending.empty())
+                return;
+
+            std::vector<char> chunk = std::move(pending.front());
+            pending.pop_front();
+
+            lock.unlock();
+            space_cv.notify_one();
+
+            bool ok = fwrite(chunk.data(), 1, chunk.size(), file) == chunk.size();
+
+            chunk.clear();
+            lock.lock();
+
+            if (!ok)
+                failed = true;
+
+            spare.push_back(std::move(chunk));
+        }
+    }
+};
+
+#endif
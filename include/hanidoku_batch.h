@@ -0,0 +1,208 @@
+#ifndef HANIDOKU_BATCH_H
+#define HANIDOKU_BATCH_H
+
+#include "hanidoku_rules.h"
+#include "hanidoku_engine.h"
+#include "dpll_solver.h"
+#include "utils.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 蜂窝数独批量求解: 分块读入题目文件, 每块在线程池上并行求解, 按输入顺序写出结果
+// 每个工作线程持有一个求解器并在各题之间重复使用
+// 输入每行一题, 去掉 "xxxx:" 前缀(若有)后取61个字符, '0'表示空格
+// 输出每行 "<61位解> <用时(微秒)>", 无解为 "unsat", 格式错误为 "invalid"
+class HanidokuBatch
+{
+public:
+    HanidokuBatch() : backend(HanidokuBackend::Native), thread_num(std::max(1u, std::thread::hardware_concurrency())), chunk_size(4096) {}
+
+    void SetBackend(HanidokuBackend backend)
+    {
+        this->backend = backend;
+    }
+
+    // 设置线程数与每块的题目数
+    void SetParallelism(int thread_num, int chunk_size)
+    {
+        this->thread_num = std::max(1, thread_num);
+        this->chunk_size = std::max(1, chunk_size);
+    }
+
+    bool Run(const std::string &input, const std::string &output)
+    {
+        std::ifstream inFile(input);
+
+        if (!inFile)
+        {
+            std::cerr << "文件打开失败，请重新读取" << std::endl;
+            return false;
+        }
+
+        std::ofstream outFile(output);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败,请重新读取" << std::endl;
+            return false;
+        }
+
+        total = solved = unsat = invalid = 0;
+
+        ThreadPool pool(thread_num, thread_num);
+        std::vector<Worker> workers(thread_num);
+        std::vector<std::string> puzzles;
+        std::vector<std::string> results;
+        std::string line;
+        std::string buffer;
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        while (true)
+        {
+            puzzles.clear();
+
+            while ((int)puzzles.size() < chunk_size && std::getline(inFile, line))
+            {
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+
+                if (line.empty())
+                    continue;
+
+                size_t start = (line.size() > 5 && line[4] == ':') ? 5 : 0;
+                puzzles.push_back(line.substr(start, 61));
+            }
+
+            if (puzzles.empty())
+                break;
+
+            results.assign(puzzles.size(), std::string());
+
+            // 各线程从共享下标领取题目, 保证负载均衡
+            std::atomic<size_t> next(0);
+            std::vector<std::future<void>> futures;
+
+            for (auto &worker : workers)
+            {
+                Worker *current = &worker;
+
+                futures.push_back(pool.EnqueueTask([this, current, &puzzles, &results, &next]()
+                                                   {
+                                                       size_t index;
+
+                                                       while ((index = next.fetch_add(1)) < puzzles.size())
+                                                       {
+                                                           results[index] = Solve(*current, puzzles[index]);
+                                                       } }));
+            }
+
+            for (auto &future : futures)
+            {
+                future.get();
+            }
+
+            buffer.clear();
+
+            for (const auto &result : results)
+            {
+                buffer += result;
+                buffer += '\n';
+
+                if (result.compare(0, 5, "unsat") == 0)
+                    ++unsat;
+                else if (result.compare(0, 7, "invalid") == 0)
+                    ++invalid;
+                else
+                    ++solved;
+            }
+
+            outFile << buffer;
+            total += puzzles.size();
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+        std::cout << "共 " << total << " 题: 有解 " << solved << ", 无解 " << unsat << ", 格式错误 " << invalid << std::endl;
+        std::cout << "运行时间为：" << duration.count() << "ms" << std::endl;
+
+        return true;
+    }
+
+    long long GetTotal() const
+    {
+        return total;
+    }
+
+    long long GetSolved() const
+    {
+        return solved;
+    }
+
+private:
+    // 每个线程独占的求解器
+    struct Worker
+    {
+        HanidokuEngine engine;
+        DPLLSolver solver;
+        DeLinkList<cnf_parser::clause> clauses;
+    };
+
+    HanidokuBackend backend;
+    int thread_num;
+    int chunk_size;
+    long long total = 0;
+    long long solved = 0;
+    long long unsat = 0;
+    long long invalid = 0;
+
+    std::string Solve(Worker &worker, const std::string &puzzle)
+    {
+        if (puzzle.size() != 61 || puzzle.find_first_not_of("0123456789") != std::string::npos)
+            return "invalid";
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        std::string solution(61, '0');
+        bool flag;
+
+        if (backend == HanidokuBackend::Native)
+        {
+            flag = worker.engine.Load(puzzle) && worker.engine.Solve();
+
+            for (int pos = 0; flag && pos < 61; ++pos)
+            {
+                solution[pos] = '0' + worker.engine.GetValue(pos);
+            }
+        }
+        else
+        {
+            HanidokuRules::Build(puzzle, worker.clauses);
+
+            // 解未通过检查时按无解处理
+            flag = worker.solver.OptimizedSolve3(worker.clauses, HanidokuRules::BoolCount) && worker.solver.IsModelValid();
+
+            std::vector<LiteralStatus> temp = worker.solver.GetAssignment();
+
+            for (int pos = 0; flag && pos < 61; ++pos)
+            {
+                for (int k = 1; k <= 9; ++k)
+                {
+                    if (temp[pos * 9 + k] == LiteralStatus::True)
+                        solution[pos] = '0' + k;
+                }
+            }
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+        return (flag ? solution : std::string("unsat")) + " " + std::to_string(duration.count());
+    }
+};
+
+#endif
@@ -0,0 +1,440 @@
+#ifndef HANIDOKU_ENGINE_H
+#define HANIDOKU_ENGINE_H
+
+#include "hanidoku_geometry.h"
+#include <cstdint>
+#include <random>
+#include <string>
+
+// 六边形数独的专用求解引擎, 不经过CNF编码
+// 每个格子的候选数字用一个位掩码表示(第 d-1 位表示数字 d)
+// 直线规则: 长度为 L 的直线上恰好填 L 个连续的不同数字, 即数字集合是某个连续窗口
+// 传播: 直线窗口过滤 + 唯一候选(naked single) + 隐性唯一(hidden single), 只重新检查候选有变化的直线
+// 搜索: 在候选最少的格子与可填位置最少的(直线, 必填数字)中选分支更少的一个
+template <int Radius>
+class HexEngine
+{
+public:
+    using Geometry = HexGeometry<Radius>;
+    using Mask = std::uint32_t;
+    using LineSet = std::uint64_t;
+
+    static constexpr int Cells = Geometry::Cells;
+    static constexpr int Digits = Geometry::Digits;
+    static constexpr Mask Full = (Mask(1) << Digits) - 1;
+
+    static_assert(Digits <= 31, "候选掩码最多支持31个数字");
+    static_assert(Geometry::Lines <= 64, "直线集合最多支持64条直线");
+
+    // 载入题目, game_data 中 '0' 表示空格; 已知数字互相矛盾时返回 false
+    bool Load(const std::string &game_data)
+    {
+        decisions = 0;
+        propagations = 0;
+
+        for (int cell = 0; cell < Cells; ++cell)
+        {
+            state.mask[cell] = Full;
+            state.value[cell] = 0;
+        }
+
+        for (int line = 0; line < Geometry::Lines; ++line)
+        {
+            state.required[line] = 0;
+        }
+
+        state.dirty = (Geometry::Lines == 64 ? ~LineSet(0) : (LineSet(1) << Geometry::Lines) - 1);
+
+        for (int cell = 0; cell < Cells && cell < (int)game_data.size(); ++cell)
+        {
+            int digit = game_data[cell] - '0';
+
+            if (digit < 1 || digit > Digits)
+                continue;
+
+            if (!Assign(cell, digit))
+                return false;
+        }
+
+        return true;
+    }
+
+    // 求解载入的题目, 有解时 GetValue 给出一个解
+    bool Solve()
+    {
+        return Search(1) > 0;
+    }
+
+    // 统计载入题目的解的数量, 到 limit 为止; 达到 limit 时 GetValue 给出最后找到的解
+    long long CountSolutions(long long limit)
+    {
+        return Search(limit);
+    }
+
+    // 搜索时随机选择分支的顺序, 用于生成随机终盘
+    void SetRandomSeed(unsigned seed)
+    {
+        randomized = true;
+        random.seed(seed);
+    }
+
+    // 决策次数超过 limit 时放弃搜索(返回无解), 小于0表示不限制
+    void SetDecisionLimit(long long limit)
+    {
+        decision_limit = limit;
+    }
+
+    // 在格子 cell 填入 digit 并从同一直线上的其他格子中删去该数字
+    bool Assign(int cell, int digit)
+    {
+        Mask bit = Mask(1) << (digit - 1);
+
+        if (!(state.mask[cell] & bit))
+            return false;
+
+        if (state.value[cell])
+            return state.value[cell] == digit;
+
+        state.value[cell] = digit;
+        state.mask[cell] = bit;
+        ++propagations;
+        MarkDirty(cell);
+
+        for (int k = 0; k < 3; ++k)
+        {
+            int line = Geometry::tables.cell_lines[cell][k];
+            const int *cells = Geometry::tables.line_cells[line];
+            int size = Geometry::tables.line_size[line];
+
+            for (int i = 0; i < size; ++i)
+            {
+                int peer = cells[i];
+
+                if (peer == cell)
+                    continue;
+
+                if (state.value[peer] == digit)
+                    return false;
+
+                if (!state.value[peer] && !Restrict(peer, state.mask[peer] & ~bit))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // 传播到不动点, 出现矛盾时返回 false
+    bool Propagate()
+    {
+        while (true)
+        {
+            while (state.dirty)
+            {
+                int line = __builtin_ctzll(state.dirty);
+                state.dirty &= state.dirty - 1;
+
+                if (!PropagateLine(line))
+                    return false;
+            }
+
+            // 唯一候选
+            bool assigned = false;
+
+            for (int cell = 0; cell < Cells; ++cell)
+            {
+                if (state.value[cell] || __builtin_popcount(state.mask[cell]) != 1)
+                    continue;
+
+                if (!Assign(cell, __builtin_ctz(state.mask[cell]) + 1))
+                    return false;
+
+                assigned = true;
+            }
+
+            if (!assigned)
+                return true;
+        }
+    }
+
+    int GetValue(int cell) const
+    {
+        return state.value[cell];
+    }
+
+    Mask GetCandidates(int cell) const
+    {
+        return state.mask[cell];
+    }
+
+    long long GetDecisions() const
+    {
+        return decisions;
+    }
+
+    long long GetPropagations() const
+    {
+        return propagations;
+    }
+
+private:
+    struct State
+    {
+        Mask mask[Cells];
+        int value[Cells];
+        Mask required[Geometry::Lines];  // 直线上所有可行窗口都包含的数字
+        LineSet dirty;                   // 需要重新检查的直线
+    };
+
+    State state;
+    long long decisions = 0;
+    long long propagations = 0;
+    long long decision_limit = -1;
+    bool randomized = false;
+    std::mt19937 random;
+
+    void MarkDirty(int cell)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            state.dirty |= LineSet(1) << Geometry::tables.cell_lines[cell][k];
+        }
+    }
+
+    // 把格子的候选缩小为 mask
+    bool Restrict(int cell, Mask mask)
+    {
+        if (mask == state.mask[cell])
+            return true;
+
+        state.mask[cell] = mask;
+        MarkDirty(cell);
+
+        return mask != 0;
+    }
+
+    // 单条直线的窗口过滤与隐性唯一
+    bool PropagateLine(int line)
+    {
+        const int *cells = Geometry::tables.line_cells[line];
+        int size = Geometry::tables.line_size[line];
+
+        Mask placed = 0;
+        Mask reachable = 0;
+
+        for (int i = 0; i < size; ++i)
+        {
+            int cell = cells[i];
+
+            if (state.value[cell])
+                placed |= state.mask[cell];
+
+            reachable |= state.mask[cell];
+        }
+
+        // 可行窗口: 包含所有已填数字, 窗口内每个数字都还有格子可填, 且每个格子都还能填窗口内的数字
+        Mask allowed = 0;
+        Mask required = Full;
+        Mask window = (Mask(1) << size) - 1;
+
+        for (int start = 0; start + size <= Digits; ++start, window <<= 1)
+        {
+            if ((placed & ~window) || (reachable & window) != window)
+                continue;
+
+            bool feasible = true;
+
+            for (int i = 0; i < size && feasible; ++i)
+            {
+                feasible = (state.mask[cells[i]] & window) != 0;
+            }
+
+            if (!feasible)
+                continue;
+
+            allowed |= window;
+            required &= window;
+        }
+
+        if (!allowed)
+            return false;
+
+        state.required[line] = required;
+
+        for (int i = 0; i < size; ++i)
+        {
+            int cell = cells[i];
+
+            if (!state.value[cell] && !Restrict(cell, state.mask[cell] & allowed))
+                return false;
+        }
+
+        // 隐性唯一: 所有可行窗口都包含的数字只剩一个格子可填
+        for (Mask need = required & ~placed; need; need &= need - 1)
+        {
+            int digit = __builtin_ctz(need) + 1;
+            Mask bit = need & (~need + 1);
+            int count = 0;
+            int last = -1;
+
+            for (int i = 0; i < size; ++i)
+            {
+                if (state.mask[cells[i]] & bit)
+                {
+                    ++count;
+                    last = cells[i];
+                }
+            }
+
+            if (count == 0)
+                return false;
+
+            if (count == 1 && !state.value[last] && !Assign(last, digit))
+                return false;
+        }
+
+        return true;
+    }
+
+    // 分支数更少时更优, 相同时随机模式下随机替换
+    bool Better(int count, int best_count)
+    {
+        return count < best_count || (randomized && count == best_count && (random() & 1));
+    }
+
+    // 返回找到的解的数量(不超过 limit)
+    long long Search(long long limit)
+    {
+        if (decision_limit >= 0 && decisions > decision_limit)
+            return 0;
+
+        if (!Propagate())
+            return 0;
+
+        // 候选最少的格子
+        int best_cell = -1;
+        int best_count = Digits + 1;
+
+        for (int cell = 0; cell < Cells; ++cell)
+        {
+            if (state.value[cell])
+                continue;
+
+            int count = __builtin_popcount(state.mask[cell]);
+
+            if (Better(count, best_count))
+            {
+                best_cell = cell;
+                best_count = count;
+            }
+        }
+
+        if (best_cell == -1)
+            return 1;
+
+        // 可填位置最少的(直线, 必填数字)
+        int best_line = -1;
+        int best_digit = 0;
+
+        for (int line = 0; line < Geometry::Lines; ++line)
+        {
+            const int *cells = Geometry::tables.line_cells[line];
+            int size = Geometry::tables.line_size[line];
+
+            Mask placed = 0;
+
+            for (int i = 0; i < size; ++i)
+            {
+                if (state.value[cells[i]])
+                    placed |= state.mask[cells[i]];
+            }
+
+            for (Mask need = state.required[line] & ~placed; need; need &= need - 1)
+            {
+                Mask bit = need & (~need + 1);
+                int count = 0;
+
+                for (int i = 0; i < size; ++i)
+                {
+                    count += (state.mask[cells[i]] & bit) != 0;
+                }
+
+                if (Better(count, best_count))
+                {
+                    best_line = line;
+                    best_digit = __builtin_ctz(bit) + 1;
+                    best_count = count;
+                }
+            }
+        }
+
+        // 列出所有分支
+        int option_cell[Digits];
+        int option_digit[Digits];
+        int options = 0;
+
+        if (best_line >= 0)
+        {
+            const int *cells = Geometry::tables.line_cells[best_line];
+            int size = Geometry::tables.line_size[best_line];
+
+            for (int i = 0; i < size; ++i)
+            {
+                if (state.mask[cells[i]] & (Mask(1) << (best_digit - 1)))
+                {
+                    option_cell[options] = cells[i];
+                    option_digit[options++] = best_digit;
+                }
+            }
+        }
+        else
+        {
+            for (Mask candidates = state.mask[best_cell]; candidates; candidates &= candidates - 1)
+            {
+                option_cell[options] = best_cell;
+                option_digit[options++] = __builtin_ctz(candidates) + 1;
+            }
+        }
+
+        if (randomized)
+        {
+            for (int i = options - 1; i > 0; --i)
+            {
+                int j = random() % (i + 1);
+                std::swap(option_cell[i], option_cell[j]);
+                std::swap(option_digit[i], option_digit[j]);
+            }
+        }
+
+        State saved = state;
+        long long found = 0;
+
+        for (int i = 0; i < options; ++i)
+        {
+            ++decisions;
+
+            if (Assign(option_cell[i], option_digit[i]))
+            {
+                found += Search(limit - found);
+
+                if (found >= limit)
+                    return found;
+            }
+
+            state = saved;
+        }
+
+        return found;
+    }
+};
+
+using HanidokuEngine = HexEngine<4>;
+
+// 数独求解方式: 经CNF编码交给SAT求解器, 或使用专用的位掩码引擎
+enum class HanidokuBackend
+{
+    SAT,
+    Native
+};
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef HANIDOKU_GENERATOR_H
+#define HANIDOKU_GENERATOR_H
+
+#include "hanidoku_engine.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 蜂窝数独批量生成
+// 每个生成单元用随机搜索得到一个新的终盘, 默认每个终盘只出一道题;
+// 可设置每个终盘经12种对称变换与数字反转(d -> 10-d)得到最多24个等价终盘以提高生成速度, 同一终盘的各题在输出中交错排列, 不会相邻
+// 每个终盘按随机顺序挖洞(每挖一个洞用专用引擎验证解仍唯一), 最后按证明唯一性所需的决策次数评定难度
+// 各单元的随机数种子只由总种子与单元序号决定, 分批大小也与线程数无关, 结果与线程数无关
+// 输出每行 "<难度><空格数(3位)>:<题目> <终盘> <决策次数>", 与求解菜单读取的 "xxxx:" 前缀格式兼容
+class HanidokuGenerator
+{
+public:
+    static constexpr int Variants = 2 * HanidokuGeometry::Symmetries;
+
+    HanidokuGenerator() : thread_num(std::max(1u, std::thread::hardware_concurrency())), blank_num(40), variants_per_grid(1), seed((unsigned)time(0)) {}
+
+    // 设置每题的目标空格数, 挖不出更多唯一解的洞时提前停止
+    void SetBlankCount(int blank_num)
+    {
+        this->blank_num = std::max(0, std::min(blank_num, HanidokuGeometry::Cells));
+    }
+
+    void SetParallelism(int thread_num)
+    {
+        this->thread_num = std::max(1, thread_num);
+    }
+
+    void SetSeed(unsigned seed)
+    {
+        this->seed = seed;
+    }
+
+    // 设置每个终盘出题的数量(1 到 Variants), 大于1时其余各题取自该终盘随机选取的等价变换
+    void SetVariantsPerGrid(int variants_per_grid)
+    {
+        this->variants_per_grid = std::max(1, std::min(variants_per_grid, Variants));
+    }
+
+    // 随机终盘: 随机顺序搜索, 决策过多时换一个随机序列重新开始
+    static std::string RandomGrid(std::mt19937 &random)
+    {
+        HanidokuEngine engine;
+        engine.SetDecisionLimit(100);
+
+        do
+        {
+            engine.SetRandomSeed(random());
+        } while (!engine.Load(std::string(HanidokuGeometry::Cells, '0')) || !engine.Solve());
+
+        std::string grid(HanidokuGeometry::Cells, '0');
+
+        for (int cell = 0; cell < HanidokuGeometry::Cells; ++cell)
+        {
+            grid[cell] = '0' + engine.GetValue(cell);
+        }
+
+        return grid;
+    }
+
+    // 第 variant 个等价终盘: variant / 2 为对称变换, 奇数时再做数字反转
+    static std::string Transform(const std::string &grid, int variant)
+    {
+        std::string result(grid.size(), '0');
+
+        for (int cell = 0; cell < HanidokuGeometry::Cells; ++cell)
+        {
+            char digit = grid[cell];
+
+            if ((variant & 1) && digit != '0')
+                digit = '0' + HanidokuGeometry::Digits + 1 - (digit - '0');
+
+            result[HanidokuGeometry::tables.symmetry[variant / 2][cell]] = digit;
+        }
+
+        return result;
+    }
+
+    // 按随机顺序挖洞, 返回挖好的题目
+    static std::string DigHoles(HanidokuEngine &engine, const std::string &grid, int blank_num, std::mt19937 &random)
+    {
+        int order[HanidokuGeometry::Cells];
+
+        for (int cell = 0; cell < HanidokuGeometry::Cells; ++cell)
+        {
+            order[cell] = cell;
+        }
+
+        std::shuffle(order, order + HanidokuGeometry::Cells, random);
+
+        std::string puzzle = grid;
+        int blank_count = 0;
+
+        for (int i = 0; i < HanidokuGeometry::Cells && blank_count < blank_num; ++i)
+        {
+            char digit = puzzle[order[i]];
+            puzzle[order[i]] = '0';
+
+            if (engine.Load(puzzle) && engine.CountSolutions(2) == 1)
+                ++blank_count;
+            else
+                puzzle[order[i]] = digit;
+        }
+
+        return puzzle;
+    }
+
+    // 难度: 1 简单(只靠传播) 2 中等 3 困难 4 专家, 依据证明解唯一所需的决策次数
+    static int Grade(HanidokuEngine &engine, const std::string &puzzle, long long &decisions)
+    {
+        engine.Load(puzzle);
+        engine.CountSolutions(2);
+
+        decisions = engine.GetDecisions();
+
+        if (decisions == 0)
+            return 1;
+        if (decisions <= 16)
+            return 2;
+        if (decisions <= 256)
+            return 3;
+
+        return 4;
+    }
+
+    // 生成 count 道题写入 output
+    bool Run(long long count, const std::string &output)
+    {
+        std::ofstream outFile(output);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败,请重新读取" << std::endl;
+            return false;
+        }
+
+        long long level_count[5] = {0};
+        int per_unit = variants_per_grid;
+        long long units = (count + per_unit - 1) / per_unit;
+        long long chunk_units = std::max(1, ChunkPuzzles / per_unit);
+        long long written = 0;
+
+        ThreadPool pool(thread_num, thread_num);
+        std::vector<HanidokuEngine> engines(thread_num);
+        std::vector<std::string> results;
+        std::vector<int> levels;
+        std::string buffer;
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        for (long long first = 0; first < units; first += chunk_units)
+        {
+            long long chunk = std::min(chunk_units, units - first);
+
+            results.assign(chunk * per_unit, std::string());
+            levels.assign(chunk * per_unit, 0);
+
+            std::atomic<long long> next(0);
+            std::vector<std::future<void>> futures;
+
+            for (auto &engine : engines)
+            {
+                HanidokuEngine *current = &engine;
+
+                futures.push_back(pool.EnqueueTask([this, current, first, chunk, per_unit, &next, &results, &levels]()
+                                                   {
+                                                       long long index;
+
+                                                       while ((index = next.fetch_add(1)) < chunk)
+                                                       {
+                                                           GenerateUnit(*current, first + index, &results[index * per_unit], &levels[index * per_unit]);
+                                                       } }));
+            }
+
+            for (auto &future : futures)
+            {
+                future.get();
+            }
+
+            buffer.clear();
+
+            // 按变换序号交错输出, 同一终盘的两道题之间隔着本批其余各单元的题
+            for (int variant = 0; variant < per_unit; ++variant)
+            {
+                for (long long index = 0; index < chunk && written < count; ++index, ++written)
+                {
+                    long long i = index * per_unit + variant;
+
+                    buffer += results[i];
+                    buffer += '\n';
+                    ++level_count[levels[i]];
+                }
+            }
+
+            outFile << buffer;
+        }
+
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+        std::cout << "共生成 " << count << " 题: 简单 " << level_count[1] << ", 中等 " << level_count[2] << ", 困难 " << level_count[3] << ", 专家 " << level_count[4] << std::endl;
+        std::cout << "运行时间为：" << duration.count() << "ms" << std::endl;
+
+        return true;
+    }
+
+private:
+    static const int ChunkPuzzles = 4096;   // 每批生成的题目数, 分批输出以限制内存占用
+
+    int thread_num;
+    int blank_num;
+    int variants_per_grid;
+    unsigned seed;
+
+    // 生成一个单元的 variants_per_grid 道题, 第一道直接使用新终盘, 其余各题使用随机选取的不同等价变换
+    void GenerateUnit(HanidokuEngine &engine, long long unit, std::string results[], int levels[])
+    {
+        std::seed_seq sequence{seed, (unsigned)unit, (unsigned)(unit >> 32)};
+        std::mt19937 random(sequence);
+
+        std::string grid = RandomGrid(random);
+
+        int order[Variants];
+
+        for (int variant = 0; variant < Variants; ++variant)
+        {
+            order[variant] = variant;
+        }
+
+        std::shuffle(order + 1, order + Variants, random);
+
+        for (int k = 0; k < variants_per_grid; ++k)
+        {
+            int variant = order[k];
+            std::string solution = Transform(grid, variant);
+            std::string puzzle = DigHoles(engine, solution, blank_num, random);
+
+            long long decisions;
+            int level = Grade(engine, puzzle, decisions);
+            int blank_count = std::count(puzzle.begin(), puzzle.end(), '0');
+
+            char prefix[8];
+            snprintf(prefix, sizeof(prefix), "%d%03d:", level, blank_count);
+
+            results[k] = prefix + puzzle + " " + solution + " " + std::to_string(decisions);
+            levels[k] = level;
+        }
+    }
+};
+
+#endif
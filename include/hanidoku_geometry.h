@@ -0,0 +1,150 @@
+#ifndef HANIDOKU_GEOMETRY_H
+#define HANIDOKU_GEOMETRY_H
+
+// 半径为 Radius 的六边形棋盘几何, 全部在编译期计算
+// 行号 r 与行内列号 c 按从上到下、从左到右编号, 格子编号 cell = 行起点 + c
+// 使用轴坐标 (q, r'), r' = r - Radius; 三个方向的直线分别为 r' 恒定、q 恒定、s = -q - r' 恒定
+template <int Radius>
+struct HexTables
+{
+    static constexpr int Rows = 2 * Radius + 1;
+    static constexpr int Cells = 3 * Radius * (Radius + 1) + 1;
+    static constexpr int Lines = 3 * Rows;
+    static constexpr int Symmetries = 12;
+
+    int row_size[Rows];           // 每行的格子数
+    int row_start[Rows];          // 每行第一个格子的编号
+    int cell_row[Cells];          // 格子所在的行
+    int cell_col[Cells];          // 格子在行内的列
+    int line_size[Lines];         // 每条直线的格子数
+    int line_cells[Lines][Rows];  // 每条直线上的格子(按行号从小到大)
+    int cell_lines[Cells][3];     // 格子所在的三条直线
+    int symmetry[Symmetries][Cells];  // 对称变换(6个旋转, 后6个先左右镜像)后格子的位置
+};
+
+// 第 r' 行最左边格子的 q 坐标
+constexpr int HexQMin(int Radius, int r)
+{
+    return -Radius > -Radius - r ? -Radius : -Radius - r;
+}
+
+template <int Radius>
+constexpr HexTables<Radius> BuildHexTables()
+{
+    constexpr int Rows = HexTables<Radius>::Rows;
+
+    HexTables<Radius> tables{};
+
+    int cell = 0;
+
+    for (int r = 0; r < Rows; ++r)
+    {
+        tables.row_size[r] = Rows - (r < Radius ? Radius - r : r - Radius);
+        tables.row_start[r] = cell;
+
+        for (int c = 0; c < tables.row_size[r]; ++c, ++cell)
+        {
+            tables.cell_row[cell] = r;
+            tables.cell_col[cell] = c;
+        }
+    }
+
+    for (int cell = 0; cell < HexTables<Radius>::Cells; ++cell)
+    {
+        int r = tables.cell_row[cell] - Radius;
+        int q = HexQMin(Radius, r) + tables.cell_col[cell];
+        int s = -q - r;
+
+        // 第 0..Rows-1 条为行, Rows..2Rows-1 条 q 恒定, 2Rows..3Rows-1 条 s 恒定
+        int lines[3] = {r + Radius, Rows + q + Radius, 2 * Rows + s + Radius};
+
+        for (int k = 0; k < 3; ++k)
+        {
+            int line = lines[k];
+
+            tables.cell_lines[cell][k] = line;
+            tables.line_cells[line][tables.line_size[line]++] = cell;
+        }
+    }
+
+    // 立方坐标 (q, r', s) 绕中心旋转60度为 (-s, -q, -r'), 左右镜像为交换 q 与 s
+    for (int t = 0; t < HexTables<Radius>::Symmetries; ++t)
+    {
+        for (int cell = 0; cell < HexTables<Radius>::Cells; ++cell)
+        {
+            int r = tables.cell_row[cell] - Radius;
+            int q = HexQMin(Radius, r) + tables.cell_col[cell];
+            int s = -q - r;
+
+            if (t >= 6)
+            {
+                int temp = q;
+                q = s;
+                s = temp;
+            }
+
+            for (int k = 0; k < t % 6; ++k)
+            {
+                int next_q = -s, next_r = -q, next_s = -r;
+
+                q = next_q;
+                r = next_r;
+                s = next_s;
+            }
+
+            tables.symmetry[t][cell] = tables.row_start[r + Radius] + q - HexQMin(Radius, r);
+        }
+    }
+
+    return tables;
+}
+
+template <int Radius>
+struct HexGeometry
+{
+    static constexpr int Rows = HexTables<Radius>::Rows;
+    static constexpr int Digits = Rows;                   // 可填数字 1..Digits
+    static constexpr int Cells = HexTables<Radius>::Cells;
+    static constexpr int Lines = HexTables<Radius>::Lines;
+    static constexpr int Symmetries = HexTables<Radius>::Symmetries;
+    static constexpr int BoolCount = Cells * Digits;
+
+    static constexpr HexTables<Radius> tables = BuildHexTables<Radius>();
+
+    // 格子 cell 填数字 digit 对应的变元
+    static constexpr int Variable(int cell, int digit)
+    {
+        return cell * Digits + digit;
+    }
+
+    // 长度为 size 的直线上必须出现的数字为 [Digits + 1 - size, size]
+    static constexpr int MandatoryLow(int size)
+    {
+        return Digits + 1 - size;
+    }
+
+    // 规则子句的数量: 格约束 + 每条直线的必填、选填与互异约束
+    static constexpr int ClauseCount()
+    {
+        int count = Cells * (1 + Digits * (Digits - 1) / 2);
+
+        for (int line = 0; line < Lines; ++line)
+        {
+            int size = tables.line_size[line];
+
+            count += 2 * size - Digits;
+            count += (Digits - size) * (Digits - size + 1) / 2;
+            count += Digits * size * (size - 1) / 2;
+        }
+
+        return count;
+    }
+};
+
+using HanidokuGeometry = HexGeometry<4>;
+
+static_assert(HanidokuGeometry::Cells == 61, "蜂窝数独有61个格子");
+static_assert(HanidokuGeometry::BoolCount == 549, "蜂窝数独有549个变元");
+static_assert(HanidokuGeometry::ClauseCount() == 7468, "蜂窝数独规则有7468个子句");
+
+#endif
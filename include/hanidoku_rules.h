@@ -0,0 +1,176 @@
+#ifndef HANIDOKU_RULES_H
+#define HANIDOKU_RULES_H
+
+#include "cnf_parser.h"
+#include "list.h"
+#include "hanidoku_geometry.h"
+#include <vector>
+#include <string>
+
+// 六边形数独规则的CNF编码, 几何信息全部来自编译期生成的 HexGeometry 表
+// 半径为4时即蜂窝数独: 61个格子 x 9个数字 = 549个变元, 共7468个子句
+// 规则子句在第一次使用时直接在内存中生成, 之后所有实例共享(只读)
+template <int Radius>
+class HexRules
+{
+public:
+    using Geometry = HexGeometry<Radius>;
+
+    static const int BoolCount = Geometry::BoolCount;
+
+    // 规则子句
+    static const std::vector<std::vector<int>> &Clauses()
+    {
+        static const std::vector<std::vector<int>> clauses = Generate();
+
+        return clauses;
+    }
+
+    // 生成规则子句与已知数字对应的单子句, game_data 中 '0' 表示空格
+    static void Build(const std::string &game_data, DeLinkList<cnf_parser::clause> &clauses)
+    {
+        clauses.clear();
+
+        for (int pos = 0; pos < Geometry::Cells && pos < (int)game_data.size(); ++pos)
+        {
+            if (game_data[pos] == '0')
+                continue;
+
+            cnf_parser::clause clause;
+            clause.literals.push_back(Geometry::Variable(pos, game_data[pos] - '0'));
+            clauses.push_back(clause);
+        }
+
+        for (const auto &literals : Clauses())
+        {
+            cnf_parser::clause clause;
+
+            for (const auto literal : literals)
+            {
+                clause.literals.push_back(literal);
+            }
+
+            clauses.push_back(clause);
+        }
+    }
+
+private:
+    // 生成一条直线上的约束
+    static void generate_clause(std::vector<std::vector<int>> &clauses, int line)
+    {
+        constexpr int digits = Geometry::Digits;
+
+        const int *cells = Geometry::tables.line_cells[line];
+        int grid_size = Geometry::tables.line_size[line];
+
+        // 必填数字
+        for (int i = Geometry::MandatoryLow(grid_size); i <= grid_size; ++i)
+        {
+            std::vector<int> clause;
+
+            for (int k = 0; k < grid_size; ++k)
+            {
+                clause.push_back(Geometry::Variable(cells[k], i));
+            }
+
+            clauses.push_back(clause);
+        }
+
+        // 选填数字
+        for (int i = grid_size + 1; i <= digits; ++i)
+        {
+            for (int j = i - grid_size; j <= digits - grid_size; ++j)
+            {
+                std::vector<int> clause;
+
+                for (int k = 0; k < grid_size; ++k)
+                {
+                    clause.push_back(Geometry::Variable(cells[k], i));
+                }
+
+                for (int k = 0; k < grid_size; ++k)
+                {
+                    clause.push_back(Geometry::Variable(cells[k], j));
+                }
+
+                clauses.push_back(clause);
+            }
+        }
+
+        // 任意两个格子不可以填写相同的数字
+        for (int i = 1; i <= digits; ++i)
+        {
+            for (int index1 = 0; index1 < grid_size; ++index1)
+            {
+                for (int index2 = index1 + 1; index2 < grid_size; ++index2)
+                {
+                    clauses.push_back({-Geometry::Variable(cells[index1], i), -Geometry::Variable(cells[index2], i)});
+                }
+            }
+        }
+    }
+
+    // 生成数独规则
+    static std::vector<std::vector<int>> Generate()
+    {
+        constexpr int digits = Geometry::Digits;
+
+        std::vector<std::vector<int>> clauses;
+        clauses.reserve(Geometry::ClauseCount());
+
+        // 格约束
+        for (int i = 0; i < Geometry::Cells; ++i)
+        {
+            std::vector<int> clause;
+
+            for (int k = 1; k <= digits; ++k)
+            {
+                clause.push_back(Geometry::Variable(i, k));
+            }
+
+            clauses.push_back(clause);
+
+            for (int k1 = 1; k1 <= digits; ++k1)
+            {
+                for (int k2 = k1 + 1; k2 <= digits; ++k2)
+                {
+                    clauses.push_back({-Geometry::Variable(i, k1), -Geometry::Variable(i, k2)});
+                }
+            }
+        }
+
+        // 行与两个方向的对角线
+        for (int line = 0; line < Geometry::Lines; ++line)
+        {
+            generate_clause(clauses, line);
+        }
+
+        return clauses;
+    }
+};
+
+using HanidokuRules = HexRules<4>;
+
+// 蜂窝数独的终盘, 供挖洞生成题目与基准测试使用
+inline constexpr const char *HanidokuEndings[20] = {"4563263847554721632638975437915428625789634463217554876363452",
+                                                    "4536232457667984532367984556813792445281673745283631456263745",
+                                                    "7856963748554123768635124795276413874128365634125787354656789",
+                                                    "5364246723575984636237985434598271678361452451726367483553624",
+                                                    "3647567853474521634536928759218374687321465684725346859775684",
+                                                    "5436263724575986343247985646598271378431652651723437684554326",
+                                                    "3574676458364132754352186758217639476839245375248669485745768",
+                                                    "5634248765335124762769853464273918535892476436875251426376534",
+                                                    "3675461543275621435428937643192768524379856376854268547356234",
+                                                    "3675454231661572434361852772489163551237486367285445876363542",
+                                                    "4632558476337152466529783424683951737492865531672468745345236",
+                                                    "5426342531626317546317842531659284754821763724863545738663574",
+                                                    "7436563584747126535829347636758129454312678672348549685778546",
+                                                    "2435653641262785433589276446978123574396582524317667845335764",
+                                                    "5236464573247986533542987626831794537986452657983442357654623",
+                                                    "6845754679887935644582137676398214537461528582437663725445637",
+                                                    "5426376354263721544251873637842961556398742487695375483663524",
+                                                    "5637461542374631524389726535928174627594863486732563857456432",
+                                                    "5632438465747251366387241524519876357861324637241548653735246",
+                                                    "2436557624363451274581273636278951427396845587493643865765423"};
+
+#endif
@@ -12,65 +12,128 @@
 #include "list.h"
 #include "cnf_parser.h"
 #include "dpll_solver.h"
+#include "hanidoku_rules.h"
+#include "hanidoku_engine.h"
+#include "hanidoku_generator.h"
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <SFML/Graphics.hpp>
 #include <vector>
 
 class Hanidoku
 {
 public:
-    Hanidoku()
+    // 规则子句由所有实例共享, 构造时不再生成或读取cnf文件
+    Hanidoku() : puzzle(61, '0') {}
+
+    // 设置输出cnf文件的路径, 为空时不输出
+    void SetCnfFile(const std::string &filename)
     {
-        InitializeClauses();
+        this->filename = filename;
+    }
 
-        cnf_parser parser;
+    // 设置求解方式
+    void SetBackend(HanidokuBackend backend)
+    {
+        this->backend = backend;
+    }
 
-        parser.ReadCNFFile(this->filename, this->clauses);
+    // 设置 SAT 求解的取消标志与进度计数器, 供界面在后台线程求解时使用
+    void SetCancelFlag(std::atomic<bool> *cancel_flag)
+    {
+        this->cancel_flag = cancel_flag;
+    }
+
+    void SetProgressCounter(std::atomic<long long> *progress_counter)
+    {
+        this->progress_counter = progress_counter;
     }
 
     // 生成数独
+    // 每轮随机取若干个候选洞并行验证, 每个洞只需一次上限为2的解计数即可判断挖去后解是否唯一
     void generate_Hanidoku(int blank_num)
     {
         // 随机化种子
         srand((int)time(0));
 
-        // 获取游戏终盘
-        int game_index = rand() % 20;
-        std::string game_data = ending_game_data[game_index];
+        // 随机生成游戏终盘
+        std::mt19937 random((unsigned)time(0));
+        std::string game_data = HanidokuGenerator::RandomGrid(random);
+
+        int thread_num = std::max(1u, std::thread::hardware_concurrency());
+        ThreadPool pool(thread_num, thread_num);
+
+        // 每轮检查的洞数与线程数相同
+        int batch_size = thread_num;
 
-        // 挖洞生成唯一解的蜂窝数独
-        for (int blank_count = 1; blank_count <= blank_num; ++blank_count)
+        // 已证明挖去后解不唯一的位置; 之后只会挖更多的洞, 这些位置永远不能再挖
+        std::vector<bool> fixed(61, false);
+
+        int blank_count = 1;
+
+        while (blank_count <= blank_num)
         {
-            // 随机一个挖洞的位置
-            int pos = -1;
-            do
+            // 随机选出本轮的候选洞
+            std::vector<int> candidates;
+
+            for (int pos = 0; pos < 61; ++pos)
             {
-                pos = rand() % 61;
-            } while (game_data[pos] == '0');
+                if (game_data[pos] != '0' && !fixed[pos])
+                    candidates.push_back(pos);
+            }
 
-            // 拷贝游戏终盘副本
-            std::string game_data_temp = game_data;
+            if (candidates.empty())
+            {
+                std::cout << "无法再挖出唯一解的洞, 共挖好 " << blank_count - 1 << " 个洞" << std::endl;
+                break;
+            }
 
-            // 挖去该洞以后解的数量
-            int sum_answer = 0;
+            for (int i = (int)candidates.size() - 1; i > 0; --i)
+            {
+                std::swap(candidates[i], candidates[rand() % (i + 1)]);
+            }
 
-            for (int k = 1; k <= 9; ++k)
+            if ((int)candidates.size() > batch_size)
+                candidates.resize(batch_size);
+
+            int batch = candidates.size();
+            std::vector<std::future<bool>> futures;
+
+            for (int index = 0; index < batch; ++index)
             {
-                game_data_temp[pos] = '0' + k;
-                if (Justify_solve(game_data_temp))
-                    ++sum_answer;
-                if (sum_answer > 1)
-                    break;
+                std::string game_data_temp = game_data;
+                game_data_temp[candidates[index]] = '0';
+
+                futures.push_back(pool.EnqueueTask([this, game_data_temp]()
+                                                   { return CountSolutions(game_data_temp, 2) == 1; }));
             }
 
-            if (sum_answer == 1)
+            std::vector<bool> unique;
+
+            for (auto &future : futures)
             {
-                game_data[pos] = '0';
-                std::cout << "挖好第 " << blank_count << " 个洞" << std::endl;
+                unique.push_back(future.get());
             }
-            else
+
+            // 挖去第一个解唯一的洞, 其余的洞在下一轮重新检查
+            bool dug = false;
+
+            for (int index = 0; index < batch; ++index)
             {
-                std::cout << "回退一次" << std::endl;
-                blank_count--;
+                if (!unique[index])
+                {
+                    fixed[candidates[index]] = true;
+                    std::cout << "回退一次" << std::endl;
+                }
+                else if (!dug)
+                {
+                    game_data[candidates[index]] = '0';
+                    std::cout << "挖好第 " << blank_count << " 个洞" << std::endl;
+                    ++blank_count;
+                    dug = true;
+                }
             }
         }
 
@@ -80,26 +143,46 @@ public:
         for (int pos = 0; pos < 61; ++pos)
         {
             game[pos + 1] = game_data[pos] - '0';
+        }
 
-            if (game_data[pos] == '0')
-                continue;
+        this->puzzle = game_data;
 
-            cnf_parser::clause clause_temp;
-            clause_temp.literals.push_back(game_data[pos] - '0' + pos * 9);
-            this->clauses.push_front(clause_temp);
+        if (!this->filename.empty())
+        {
+            DeLinkList<cnf_parser::clause> clauses;
+            HanidokuRules::Build(this->puzzle, clauses);
+            WriteCnfFile(this->filename, clauses);
         }
 
-        WriteCnfFile(this->filename, this->clauses);
-
         show(game);
     }
 
     // 求解数独
     void solve()
     {
+        if (backend == HanidokuBackend::Native)
+        {
+            int solution[62] = {0};
+
+            if (!SolveNative(this->puzzle, solution))
+                std::cout << "无解" << std::endl;
+            else
+                show(solution);
+
+            return;
+        }
+
         extern DPLLSolver dpll_solver;
 
-        dpll_solver.BasicSolve(this->clauses, 549);
+        DeLinkList<cnf_parser::clause> clauses;
+        HanidokuRules::Build(this->puzzle, clauses);
+
+        // 解未通过检查时按无解处理
+        if (!dpll_solver.BasicSolve(clauses, HanidokuRules::BoolCount) || !dpll_solver.IsModelValid())
+        {
+            std::cout << "无解" << std::endl;
+            return;
+        }
 
         std::vector<LiteralStatus> temp = dpll_solver.GetAssignment();
 
@@ -136,27 +219,42 @@ public:
 
             // 记录读到的数独并打印
             int game[62] = {0};
-            DeLinkList<cnf_parser::clause> clauses_temp = this->clauses;
+            DeLinkList<cnf_parser::clause> clauses_temp;
+            HanidokuRules::Build(line, clauses_temp);
 
             for (int pos = 0; pos < 61; ++pos)
             {
                 game[pos + 1] = line[pos] - '0';
-
-                if (line[pos] == '0')
-                    continue;
-
-                cnf_parser::clause clause_temp;
-                clause_temp.literals.push_back(line[pos] - '0' + pos * 9);
-                clauses_temp.push_front(clause_temp);
             }
 
             std::cout << "数独：" << std::endl;
 
             show(game);
 
+            if (backend == HanidokuBackend::Native)
+            {
+                int solution[62] = {0};
+
+                auto start_time = std::chrono::high_resolution_clock::now();
+                bool flag = SolveNative(line, solution);
+                auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+                if (!flag)
+                {
+                    std::cout << "无解" << std::endl;
+                    continue;
+                }
+
+                std::cout << "解(用时 " << duration.count() << " 微秒)：" << std::endl;
+
+                show(solution);
+                continue;
+            }
+
             extern DPLLSolver dpll_solver;
 
-            if (!dpll_solver.OptimizedSolve1(clauses_temp, 549))
+            // 解未通过检查时按无解处理
+            if (!dpll_solver.OptimizedSolve1(clauses_temp, HanidokuRules::BoolCount) || !dpll_solver.IsModelValid())
             {
                 std::cout << "无解" << std::endl;
                 continue;
@@ -189,30 +287,45 @@ public:
             for (auto literal : row)
             {
                 ++pos;
-                if (literal == 0)
-                    continue;
-                cnf_parser::clause temp;
-                temp.literals.push_back(pos * 9 + literal);
-                this->clauses.push_front(temp);
+                this->puzzle[pos] = '0' + literal;
             }
         }
 
-        WriteCnfFile(this->filename, this->clauses);
+        DeLinkList<cnf_parser::clause> clauses;
+        HanidokuRules::Build(this->puzzle, clauses);
 
-        extern DPLLSolver dpll_solver;
-
-        bool flag = dpll_solver.BasicSolve(this->clauses, 549);
-
-        std::vector<LiteralStatus> temp = dpll_solver.GetAssignment();
+        if (!this->filename.empty())
+            WriteCnfFile(this->filename, clauses);
 
         int solution[62] = {0};
+        bool flag;
 
-        for (pos = 0; pos < 61; ++pos)
+        if (backend == HanidokuBackend::Native)
         {
-            for (int k = 1; k <= 9; ++k)
+            flag = SolveNative(this->puzzle, solution);
+        }
+        else
+        {
+            extern DPLLSolver dpll_solver;
+
+            dpll_solver.SetCancelFlag(this->cancel_flag);
+            dpll_solver.SetProgressCounter(this->progress_counter);
+
+            // 解未通过检查时按无解处理
+            flag = dpll_solver.BasicSolve(clauses, HanidokuRules::BoolCount) && dpll_solver.IsModelValid();
+
+            dpll_solver.SetCancelFlag(nullptr);
+            dpll_solver.SetProgressCounter(nullptr);
+
+            std::vector<LiteralStatus> temp = dpll_solver.GetAssignment();
+
+            for (pos = 0; pos < 61; ++pos)
             {
-                if (temp[pos * 9 + k] == LiteralStatus::True)
-                    solution[pos + 1] = k;
+                for (int k = 1; k <= 9; ++k)
+                {
+                    if (temp[pos * 9 + k] == LiteralStatus::True)
+                        solution[pos + 1] = k;
+                }
             }
         }
 
@@ -230,284 +343,42 @@ public:
     }
 
 private:
-    DeLinkList<cnf_parser::clause> clauses;
+    std::string puzzle;    // 当前数独, '0' 表示空格
     std::string filename;
-    int index[9] = {0, 5, 11, 18, 26, 35, 43, 50, 56};
+    HanidokuBackend backend = HanidokuBackend::SAT;
+    std::atomic<bool> *cancel_flag = nullptr;
+    std::atomic<long long> *progress_counter = nullptr;
     const std::vector<int> rowSizes_ = {5, 6, 7, 8, 9, 8, 7, 6, 5}; // 每行的格子数
-    std::string ending_game_data[20] = {"4563263847554721632638975437915428625789634463217554876363452",
-                                        "4536232457667984532367984556813792445281673745283631456263745",
-                                        "7856963748554123768635124795276413874128365634125787354656789",
-                                        "5364246723575984636237985434598271678361452451726367483553624",
-                                        "3647567853474521634536928759218374687321465684725346859775684",
-                                        "5436263724575986343247985646598271378431652651723437684554326",
-                                        "3574676458364132754352186758217639476839245375248669485745768",
-                                        "5634248765335124762769853464273918535892476436875251426376534",
-                                        "3675461543275621435428937643192768524379856376854268547356234",
-                                        "3675454231661572434361852772489163551237486367285445876363542",
-                                        "4632558476337152466529783424683951737492865531672468745345236",
-                                        "5426342531626317546317842531659284754821763724863545738663574",
-                                        "7436563584747126535829347636758129454312678672348549685778546",
-                                        "2435653641262785433589276446978123574396582524317667845335764",
-                                        "5236464573247986533542987626831794537986452657983442357654623",
-                                        "6845754679887935644582137676398214537461528582437663725445637",
-                                        "5426376354263721544251873637842961556398742487695375483663524",
-                                        "5637461542374631524389726535928174627594863486732563857456432",
-                                        "5632438465747251366387241524519876357861324637241548653735246",
-                                        "2436557624363451274581273636278951427396845587493643865765423"};
 
-    // 求解数独
-    bool Justify_solve(std::string game_data)
+    // 统计数独解的数量, 到 limit 为止; 每次使用独立的求解器以便并行调用
+    long long CountSolutions(const std::string &game_data, long long limit)
     {
-        DeLinkList<cnf_parser::clause> clauses_temp = this->clauses;
+        DeLinkList<cnf_parser::clause> clauses_temp;
+        HanidokuRules::Build(game_data, clauses_temp);
 
-        extern DPLLSolver dpll_solver;
+        DPLLSolver solver;
 
-        for (int pos = 0; pos < 61; ++pos)
-        {
-            if (game_data[pos] == '0')
-                continue;
-
-            cnf_parser::clause clause_temp;
-            clause_temp.literals.push_back(game_data[pos] - '0' + pos * 9);
-            clauses_temp.push_front(clause_temp);
-        }
-
-        return dpll_solver.BasicSolve(clauses_temp, 549);
+        return solver.CountSolutions(clauses_temp, HanidokuRules::BoolCount, limit);
     }
 
-    // 生成行、对角线约束
-    void generate_clause(std::string filename, std::vector<int> positions, int grid_size)
+    // 用专用引擎求解, 解写入 solution[1..61]
+    bool SolveNative(const std::string &game_data, int solution[])
     {
-        std::ofstream outFile(filename, std::ios::app); // 打开文件并且追加内容
-
-        if (!outFile)
-        {
-            // 处理打开失败的文件
-            std::cerr << "文件打开失败,请重新读取" << std::endl;
-            return;
-        }
+        HanidokuEngine engine;
 
-        switch (grid_size)
-        {
-        case 5:
-            // 必填数字
-            for (int i = 5; i <= 5; ++i)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-                outFile << "0" << std::endl;
-            }
-
-            break;
-
-        case 6:
-            // 必填数字
-            for (int i = 4; i <= 6; ++i)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-                outFile << "0" << std::endl;
-            }
-
-            break;
-
-        case 7:
-            // 必填数字
-            for (int i = 3; i <= 7; ++i)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-                outFile << "0" << std::endl;
-            }
-
-            break;
-
-        case 8:
-            // 必填数字
-            for (int i = 2; i <= 8; ++i)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-                outFile << "0" << std::endl;
-            }
-
-            break;
-
-        case 9:
-            // 必填数字
-            for (int i = 1; i <= 9; ++i)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-                outFile << "0" << std::endl;
-            }
-
-            break;
-
-        default:
-            break;
-        }
-
-        // 选填数字
-        for (int i = grid_size + 1; i <= 9; ++i)
-        {
-            for (int j = i - grid_size; j <= 9 - grid_size; ++j)
-            {
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + i;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-
-                for (const auto position : positions)
-                {
-                    int literal = position * 10 + j;
-                    literal = transmission(literal);
-                    outFile << literal << " ";
-                }
-
-                outFile << "0" << std::endl;
-            }
-        }
-
-        // 任意两个格子不可以填写相同的数字
-        for (int i = 1; i <= 9; ++i)
-        {
-            for (int index1 = 0; index1 < grid_size; ++index1)
-            {
-                for (int index2 = index1 + 1; index2 < grid_size; ++index2)
-                {
-                    int literal1 = positions[index1] * 10 + i;
-                    int literal2 = positions[index2] * 10 + i;
-                    literal1 = transmission(literal1);
-                    literal2 = transmission(literal2);
-                    outFile << -literal1 << " " << -literal2 << " 0" << std::endl;
-                }
-            }
-        }
-
-        outFile.close();
-    }
-
-    // 初始化数独规则
-    void InitializeClauses()
-    {
-        std::cout << "请输入生成的cnf文件路径: ";
-        std::cin >> this->filename;
-
-        std::ofstream outFile(filename);
-
-        if (!outFile)
-        {
-            // 处理打开失败的文件
-            std::cerr << "文件打开失败,请重新读取" << std::endl;
-            return;
-        }
-
-        outFile << "p cnf " << 549 << " " << 7468 << std::endl;
+        if (!engine.Load(game_data) || !engine.Solve())
+            return false;
 
-        // 格约束
-        for (int i = 0; i < 61; ++i)
+        for (int pos = 0; pos < 61; ++pos)
         {
-            for (int k = 1; k <= 9; ++k)
-            {
-                outFile << i * 9 + k << " ";
-            }
-
-            outFile << "0" << std::endl;
-
-            for (int k1 = 1; k1 <= 9; ++k1)
-            {
-                for (int k2 = k1 + 1; k2 <= 9; ++k2)
-                {
-                    outFile << -(i * 9 + k1) << " " << -(i * 9 + k2) << " 0" << std::endl;
-                }
-            }
+            solution[pos + 1] = engine.GetValue(pos);
         }
 
-        outFile.close();
-
-        // 5 格的规则
-        generate_clause(filename, std::vector<int>({11, 12, 13, 14, 15}), 5);
-        generate_clause(filename, std::vector<int>({11, 21, 31, 41, 51}), 5);
-        generate_clause(filename, std::vector<int>({51, 61, 71, 81, 91}), 5);
-        generate_clause(filename, std::vector<int>({91, 92, 93, 94, 95}), 5);
-        generate_clause(filename, std::vector<int>({59, 68, 77, 86, 95}), 5);
-        generate_clause(filename, std::vector<int>({15, 26, 37, 48, 59}), 5);
-
-        // 6 格的规则
-        generate_clause(filename, std::vector<int>({21, 22, 23, 24, 25, 26}), 6);
-        generate_clause(filename, std::vector<int>({12, 22, 32, 42, 52, 61}), 6);
-        generate_clause(filename, std::vector<int>({41, 52, 62, 72, 82, 92}), 6);
-        generate_clause(filename, std::vector<int>({81, 82, 83, 84, 85, 86}), 6);
-        generate_clause(filename, std::vector<int>({48, 58, 67, 76, 85, 94}), 6);
-        generate_clause(filename, std::vector<int>({14, 25, 36, 47, 58, 68}), 6);
-
-        // 7 格的规则
-        generate_clause(filename, std::vector<int>({31, 32, 33, 34, 35, 36, 37}), 7);
-        generate_clause(filename, std::vector<int>({13, 23, 33, 43, 53, 62, 71}), 7);
-        generate_clause(filename, std::vector<int>({31, 42, 53, 63, 73, 83, 93}), 7);
-        generate_clause(filename, std::vector<int>({71, 72, 73, 74, 75, 76, 77}), 7);
-        generate_clause(filename, std::vector<int>({37, 47, 57, 66, 75, 84, 93}), 7);
-        generate_clause(filename, std::vector<int>({13, 24, 35, 46, 57, 67, 77}), 7);
-
-        // 8 格的规则
-        generate_clause(filename, std::vector<int>({41, 42, 43, 44, 45, 46, 47, 48}), 8);
-        generate_clause(filename, std::vector<int>({14, 24, 34, 44, 54, 63, 72, 81}), 8);
-        generate_clause(filename, std::vector<int>({21, 32, 43, 54, 64, 74, 84, 94}), 8);
-        generate_clause(filename, std::vector<int>({61, 62, 63, 64, 65, 66, 67, 68}), 8);
-        generate_clause(filename, std::vector<int>({26, 36, 46, 56, 65, 74, 83, 92}), 8);
-        generate_clause(filename, std::vector<int>({12, 23, 34, 45, 56, 66, 76, 86}), 8);
-
-        // 9 格的规则
-        generate_clause(filename, std::vector<int>({51, 52, 53, 54, 55, 56, 57, 58, 59}), 9);
-        generate_clause(filename, std::vector<int>({15, 25, 35, 45, 55, 64, 73, 82, 91}), 9);
-        generate_clause(filename, std::vector<int>({11, 22, 33, 44, 55, 65, 75, 85, 95}), 9);
-    }
-
-    // 变元映射
-    int transmission(int literal)
-    {
-        int bool_variation = 0;
-        int x = literal % 10;
-
-        bool_variation += x;
-
-        literal = literal / 10;
-        x = literal % 10;
-
-        bool_variation += (x - 1) * 9;
-
-        x = literal / 10;
-
-        bool_variation += index[x - 1] * 9;
-
-        return bool_variation;
+        return true;
     }
 
     // 输出cnf文件
-    void WriteCnfFile(std::string filename, DeLinkList<cnf_parser::clause> clauses)
+    void WriteCnfFile(const std::string &filename, DeLinkList<cnf_parser::clause> &clauses)
     {
         std::ofstream outFile(filename);
 
@@ -606,20 +477,51 @@ public:
         solveButton_.setFillColor(sf::Color::Green);
         solveButton_.setPosition({500.0, windowHeight_ - 140.0});
 
+        // 创建取消按钮, 与求解按钮位置相同, 只在求解过程中显示
+        cancelButton_.setSize(sf::Vector2f(90, 40));
+        cancelButton_.setFillColor(sf::Color::Red);
+        cancelButton_.setPosition({500.0, windowHeight_ - 140.0});
+
         // 创建生成按钮
         generateButton_.setSize(sf::Vector2f(100, 40));
         generateButton_.setFillColor(sf::Color::Blue);
         generateButton_.setPosition({windowWidth_ - 200.0, 300.0});
 
         solving_ = false; // 初始状态下未求解数独
+
+        updateHints();
+        buildStaticLayer();
+    }
+
+    ~HexagonalSudokuGame()
+    {
+        // 窗口关闭时取消仍在进行的求解
+        if (worker_.joinable())
+        {
+            cancel_ = true;
+            worker_.join();
+        }
     }
 
     void run()
     {
+        // 求解在后台线程进行, 渲染循环保持固定帧率
+        window_.setFramerateLimit(60);
+
         while (window_.isOpen())
         {
-            drawBoard();
+            // 画面没有变化且不在求解时阻塞等待事件, 空闲时不占用CPU
+            if (!solving_ && !dirty_)
+            {
+                sf::Event event;
+
+                if (window_.waitEvent(event))
+                    handleEvent(event);
+            }
+
             handleEvents();
+            pollSolver();
+            drawBoard();
         }
     }
 
@@ -632,8 +534,19 @@ private:
     sf::RectangleShape colInputBox_;
     sf::RectangleShape valueInputBox_;
     sf::RectangleShape solveButton_;
+    sf::RectangleShape cancelButton_;
     sf::RectangleShape generateButton_;
+    sf::RectangleShape focusRect_;
     bool solving_ = false; // 标志位，用于指示是否正在求解数独
+
+    // 后台求解
+    std::thread worker_;
+    std::atomic<bool> cancel_{false};           // 取消按钮置位, 求解器检查后尽快返回
+    std::atomic<bool> finished_{false};         // 后台线程求解结束
+    std::atomic<long long> progress_{0};        // 已访问的搜索结点数
+    std::mutex result_mtx_;
+    std::vector<std::vector<int>> resultBoard_;
+    bool resultFlag_ = false;
     std::string currentRowInput_;
     std::string currentColInput_;
     std::string currentValueInput_;
@@ -643,6 +556,37 @@ private:
     std::vector<std::vector<int>> sudokuBoard_;
     std::string filename_;
 
+    // 保留模式绘制: 棋盘、标签等静态内容只画一次到 boardLayer_, 之后只重画数字有变化的格子
+    const float hexagonWidth_ = 80.0f;
+    const float hexagonHeight_ = 100.0f;
+    sf::RenderTexture boardLayer_;
+    sf::Sprite boardSprite_;
+    sf::ConvexShape hexagon_;
+    sf::Text cellText_;
+    std::vector<std::vector<int>> drawnBoard_; // boardLayer_ 中每个格子当前画的数字, -1 表示还没画
+    std::vector<std::vector<int>> drawnStyle_; // boardLayer_ 中每个格子当前的样式
+    sf::Text rowInputText_;
+    sf::Text colInputText_;
+    sf::Text valueInputText_;
+    sf::Text solveText_;
+    sf::Text cancelText_;
+    sf::Text solvingText_;
+    bool dirty_ = true; // 画面需要重画
+
+    // 实时提示: 每次输入后在专用引擎上传播, 标出冲突的格子与被推出的格子
+    // 在空格中填数时直接在上一次传播的结果上继续传播, 修改或清除数字时才重新载入
+    enum CellStyle
+    {
+        Normal,
+        Forced,  // 由已填数字推出, 显示推出的数字
+        Conflict // 与同一直线上的数字冲突或导致无解
+    };
+
+    HanidokuEngine hintEngine_;
+    bool hintConsistent_ = false;              // hintEngine_ 的状态没有矛盾, 可以增量传播
+    std::vector<std::vector<int>> hintBoard_;  // 每个格子显示的数字
+    std::vector<std::vector<int>> cellStyle_;  // 每个格子的样式
+
     enum class InputField
     {
         Row,
@@ -652,140 +596,306 @@ private:
 
     InputField currentInputField_ = InputField::Row;
 
-    // 绘制 canva
-    void drawBoard()
+    // 第 row 行第 col 个格子左上角的坐标
+    sf::Vector2f cellOrigin(int row, int col) const
     {
-        window_.clear(sf::Color::White);
+        float start_x = std::abs(4 - row) * hexagonWidth_ / 2 + 40.0f;
+        float start_y = row * 3 * hexagonHeight_ / 4 + 150.0f;
+
+        return {start_x + col * hexagonWidth_, start_y};
+    }
+
+    // 建立静态层: 六边形、输入框、标签与生成按钮只画一次
+    void buildStaticLayer()
+    {
+        if (!boardLayer_.create(windowWidth_, windowHeight_))
+        {
+            std::cerr << "Error creating render texture!" << std::endl;
+            exit(1);
+        }
+
+        // 设置蜂窝的顶点, 绘制时平移到格子的位置
+        hexagon_.setPointCount(6);
+        hexagon_.setPoint(0, sf::Vector2f(hexagonWidth_ / 2, 0));
+        hexagon_.setPoint(1, sf::Vector2f(hexagonWidth_, hexagonHeight_ / 4));
+        hexagon_.setPoint(2, sf::Vector2f(hexagonWidth_, 3 * hexagonHeight_ / 4));
+        hexagon_.setPoint(3, sf::Vector2f(hexagonWidth_ / 2, hexagonHeight_));
+        hexagon_.setPoint(4, sf::Vector2f(0, 3 * hexagonHeight_ / 4));
+        hexagon_.setPoint(5, sf::Vector2f(0, hexagonHeight_ / 4));
+        hexagon_.setFillColor(sf::Color::White);
+        hexagon_.setOutlineThickness(2.0f);
+        hexagon_.setOutlineColor(sf::Color::Black);
+
+        cellText_.setFont(font_);
+        cellText_.setCharacterSize(30);
+        cellText_.setFillColor(sf::Color::Black);
 
-        // 定义六边形的宽度和高度
-        float hexagonWidth = 80.0f;
-        float hexagonHeight = 100.0f;
+        boardLayer_.clear(sf::Color::White);
+
+        // 绘制行、列、值输入框和标签
+        boardLayer_.draw(rowInputBox_);
+        boardLayer_.draw(colInputBox_);
+        boardLayer_.draw(valueInputBox_);
+
+        sf::Text rowLabel("Row:", font_, 30);
+        rowLabel.setFillColor(sf::Color::Black);
+        rowLabel.setPosition({100.0, windowHeight_ - 200.0});
+        boardLayer_.draw(rowLabel);
+
+        sf::Text colLabel("Col:", font_, 30);
+        colLabel.setFillColor(sf::Color::Black);
+        colLabel.setPosition({220.0, windowHeight_ - 200.0});
+        boardLayer_.draw(colLabel);
+
+        sf::Text valueLabel("Value:", font_, 30);
+        valueLabel.setFillColor(sf::Color::Black);
+        valueLabel.setPosition({340.0, windowHeight_ - 200.0});
+        boardLayer_.draw(valueLabel);
+
+        // 生成按钮
+        sf::Text generateText("Generate", font_, 20);
+        generateText.setFillColor(sf::Color::White);
+        generateText.setPosition({windowWidth_ - 200.0, 300.0});
+        boardLayer_.draw(generateButton_);
+        boardLayer_.draw(generateText);
+
+        // 格子在第一次 syncCells 时画出
+        drawnBoard_.assign(numRows_, std::vector<int>());
+        drawnStyle_.assign(numRows_, std::vector<int>());
 
-        // 绘制蜂窝数独板
         for (int row = 0; row < numRows_; ++row)
         {
-            int start_x = std::abs(4 - row) * hexagonWidth / 2 + 40.0f;
-            int start_y = row * 3 * hexagonHeight / 4 + 150.0f;
+            drawnBoard_[row].assign(rowSizes_[row], -1);
+            drawnStyle_[row].assign(rowSizes_[row], Normal);
+        }
+
+        syncCells();
+        boardLayer_.display();
+        boardSprite_.setTexture(boardLayer_.getTexture());
 
+        // 每帧都要画的动态内容
+        rowInputText_ = sf::Text("", font_, 30);
+        rowInputText_.setFillColor(sf::Color::Black);
+        rowInputText_.setPosition({120.0, windowHeight_ - 145});
+
+        colInputText_ = sf::Text("", font_, 30);
+        colInputText_.setFillColor(sf::Color::Black);
+        colInputText_.setPosition({230.0, windowHeight_ - 145});
+
+        valueInputText_ = sf::Text("", font_, 30);
+        valueInputText_.setFillColor(sf::Color::Black);
+        valueInputText_.setPosition({350.0, windowHeight_ - 145});
+
+        focusRect_.setSize(sf::Vector2f(100, 50));
+        focusRect_.setFillColor(sf::Color::Transparent);
+        focusRect_.setOutlineThickness(2);
+        focusRect_.setOutlineColor(sf::Color::Red);
+
+        solveText_ = sf::Text("Solve", font_, 25);
+        solveText_.setFillColor(sf::Color::Black);
+        solveText_.setPosition({510.0, windowHeight_ - 140});
+
+        cancelText_ = sf::Text("Cancel", font_, 25);
+        cancelText_.setFillColor(sf::Color::Black);
+        cancelText_.setPosition({505.0, windowHeight_ - 140});
+
+        solvingText_ = sf::Text("", font_, 25);
+        solvingText_.setFillColor(sf::Color::Black);
+        solvingText_.setPosition({500.0, windowHeight_ - 200});
+    }
+
+    // 在静态层上重画一个格子
+    void drawCell(int row, int col, int value, int style)
+    {
+        sf::Vector2f origin = cellOrigin(row, col);
+
+        hexagon_.setPosition(origin);
+        hexagon_.setFillColor(style == Conflict ? sf::Color(255, 150, 150) : (style == Forced ? sf::Color(200, 240, 200) : sf::Color::White));
+        boardLayer_.draw(hexagon_);
+
+        cellText_.setString(std::to_string(value));
+        cellText_.setFillColor(style == Forced ? sf::Color(110, 110, 110) : sf::Color::Black);
+        cellText_.setPosition({origin.x + hexagonWidth_ / 2 - 10.0f, origin.y + hexagonHeight_ / 2 - 10.0f});
+        boardLayer_.draw(cellText_);
+    }
+
+    // 只重画数字或样式有变化的格子, 返回是否有格子被重画
+    bool syncCells()
+    {
+        bool changed = false;
+
+        for (int row = 0; row < numRows_; ++row)
+        {
             for (int col = 0; col < rowSizes_[row]; ++col)
             {
-                sf::ConvexShape hexagon;
-                hexagon.setPointCount(6);
+                if (drawnBoard_[row][col] == hintBoard_[row][col] && drawnStyle_[row][col] == cellStyle_[row][col])
+                    continue;
 
-                // 计算蜂窝的位置，以六边形的中心为旋转点
-                float x = start_x + col * hexagonWidth;
-                float y = start_y;
+                drawnBoard_[row][col] = hintBoard_[row][col];
+                drawnStyle_[row][col] = cellStyle_[row][col];
+                drawCell(row, col, hintBoard_[row][col], cellStyle_[row][col]);
+                changed = true;
+            }
+        }
 
-                // 设置蜂窝的顶点
-                hexagon.setPoint(0, sf::Vector2f(x + hexagonWidth / 2, y));
-                hexagon.setPoint(1, sf::Vector2f(x + hexagonWidth, y + hexagonHeight / 4));
-                hexagon.setPoint(2, sf::Vector2f(x + hexagonWidth, y + 3 * hexagonHeight / 4));
-                hexagon.setPoint(3, sf::Vector2f(x + hexagonWidth / 2, y + hexagonHeight));
-                hexagon.setPoint(4, sf::Vector2f(x, y + 3 * hexagonHeight / 4));
-                hexagon.setPoint(5, sf::Vector2f(x, y + hexagonHeight / 4));
+        return changed;
+    }
 
-                // 设置蜂窝的边框
-                hexagon.setOutlineThickness(2.0f);
-                hexagon.setOutlineColor(sf::Color::Black);
+    // 数独板是否为完整的 9 行
+    bool isBoardComplete() const
+    {
+        if ((int)sudokuBoard_.size() != numRows_)
+            return false;
 
-                window_.draw(hexagon);
+        for (int row = 0; row < numRows_; ++row)
+        {
+            if ((int)sudokuBoard_[row].size() != rowSizes_[row])
+                return false;
+        }
+
+        return true;
+    }
+
+    // 更新提示; 在空格 (row, col) 中新填了数字时传入该格, 否则重新载入整个数独板
+    void updateHints(int row = -1, int col = -1)
+    {
+        hintBoard_.assign(numRows_, std::vector<int>());
+        cellStyle_.assign(numRows_, std::vector<int>());
 
-                // 创建文本输入框
-                sf::Text inputText(std::to_string(sudokuBoard_[row][col]), font_, 30.0f);
-                inputText.setFillColor(sf::Color::Black);
+        for (int r = 0; r < numRows_; ++r)
+        {
+            hintBoard_[r].assign(rowSizes_[r], 0);
+            cellStyle_[r].assign(rowSizes_[r], Normal);
+        }
+
+        if (!isBoardComplete())
+        {
+            hintConsistent_ = false;
+            return;
+        }
 
-                // 设置文本框位置，这里可以根据需要微调
-                float textX = x + hexagonWidth / 2 - 10.0f;
-                float textY = y + hexagonHeight / 2 - 10.0f;
+        const auto &tables = HanidokuGeometry::tables;
 
-                inputText.setPosition({textX, textY});
+        // 增量传播, 之前已有矛盾或改动了已填的数字时重新载入
+        if (row >= 0 && hintConsistent_)
+        {
+            hintConsistent_ = hintEngine_.Assign(tables.row_start[row] + col, sudokuBoard_[row][col]) && hintEngine_.Propagate();
+        }
+        else
+        {
+            std::string game_data(HanidokuGeometry::Cells, '0');
 
-                window_.draw(inputText);
+            for (int r = 0; r < numRows_; ++r)
+            {
+                for (int c = 0; c < rowSizes_[r]; ++c)
+                {
+                    game_data[tables.row_start[r] + c] = '0' + sudokuBoard_[r][c];
+                }
             }
+
+            hintConsistent_ = hintEngine_.Load(game_data) && hintEngine_.Propagate();
         }
 
-        // 绘制行、列、值输入框和标签
-        window_.draw(rowInputBox_);
-        window_.draw(colInputBox_);
-        window_.draw(valueInputBox_);
+        // 已填的数字照常显示, 空格在没有矛盾时显示推出的数字
+        for (int cell = 0; cell < HanidokuGeometry::Cells; ++cell)
+        {
+            int r = tables.cell_row[cell];
+            int c = tables.cell_col[cell];
 
-        sf::Text rowLabel("Row:", font_, 30);
-        rowLabel.setFillColor(sf::Color::Black);
-        rowLabel.setPosition({100.0, windowHeight_ - 200.0});
-        window_.draw(rowLabel);
+            hintBoard_[r][c] = sudokuBoard_[r][c];
 
-        sf::Text colLabel("Col:", font_, 30);
-        colLabel.setFillColor(sf::Color::Black);
-        colLabel.setPosition({220.0, windowHeight_ - 200.0});
-        window_.draw(colLabel);
+            if (!sudokuBoard_[r][c] && hintConsistent_ && hintEngine_.GetValue(cell))
+            {
+                hintBoard_[r][c] = hintEngine_.GetValue(cell);
+                cellStyle_[r][c] = Forced;
+            }
+        }
 
-        sf::Text valueLabel("Value:", font_, 30);
-        valueLabel.setFillColor(sf::Color::Black);
-        valueLabel.setPosition({340.0, windowHeight_ - 200.0});
-        window_.draw(valueLabel);
+        if (hintConsistent_)
+            return;
 
-        // 绘制输入框中的文本
-        sf::Text rowInputText(currentRowInput_, font_, 30);
-        rowInputText.setFillColor(sf::Color::Black);
-        rowInputText.setPosition({120.0, windowHeight_ - 145});
-        window_.draw(rowInputText);
+        // 同一直线上的相同数字互相冲突
+        bool found = false;
+
+        for (int line = 0; line < HanidokuGeometry::Lines; ++line)
+        {
+            for (int i = 0; i < tables.line_size[line]; ++i)
+            {
+                for (int j = i + 1; j < tables.line_size[line]; ++j)
+                {
+                    int a = tables.line_cells[line][i];
+                    int b = tables.line_cells[line][j];
+                    int value = sudokuBoard_[tables.cell_row[a]][tables.cell_col[a]];
 
-        sf::Text colInputText(currentColInput_, font_, 30);
-        colInputText.setFillColor(sf::Color::Black);
-        colInputText.setPosition({230.0, windowHeight_ - 145});
-        window_.draw(colInputText);
+                    if (value && value == sudokuBoard_[tables.cell_row[b]][tables.cell_col[b]])
+                    {
+                        cellStyle_[tables.cell_row[a]][tables.cell_col[a]] = Conflict;
+                        cellStyle_[tables.cell_row[b]][tables.cell_col[b]] = Conflict;
+                        found = true;
+                    }
+                }
+            }
+        }
 
-        sf::Text valueInputText(currentValueInput_, font_, 30);
-        valueInputText.setFillColor(sf::Color::Black);
-        valueInputText.setPosition({350.0, windowHeight_ - 145});
-        window_.draw(valueInputText);
+        // 没有重复数字但传播出现矛盾时, 标出刚填的格子
+        if (!found && row >= 0)
+            cellStyle_[row][col] = Conflict;
 
-        // 绘制焦点框
-        sf::RectangleShape focusRect;
-        focusRect.setSize(sf::Vector2f(100, 50));
-        focusRect.setFillColor(sf::Color::Transparent);
-        focusRect.setOutlineThickness(2);
-        focusRect.setOutlineColor(sf::Color::Red);
+        std::cerr << "当前数独无解" << std::endl;
+    }
+
+    // 绘制 canva, 画面没有变化时直接跳过
+    void drawBoard()
+    {
+        if (!dirty_)
+            return;
+
+        dirty_ = false;
+
+        if (syncCells())
+            boardLayer_.display();
+
+        window_.clear(sf::Color::White);
+        window_.draw(boardSprite_);
+
+        // 绘制输入框中的文本
+        rowInputText_.setString(currentRowInput_);
+        colInputText_.setString(currentColInput_);
+        valueInputText_.setString(currentValueInput_);
+        window_.draw(rowInputText_);
+        window_.draw(colInputText_);
+        window_.draw(valueInputText_);
 
+        // 绘制焦点框
         if (currentInputField_ == InputField::Row)
         {
-            focusRect.setPosition({100.0, windowHeight_ - 140.0});
+            focusRect_.setPosition({100.0, windowHeight_ - 140.0});
         }
         else if (currentInputField_ == InputField::Col)
         {
-            focusRect.setPosition({220.0, windowHeight_ - 140.0});
+            focusRect_.setPosition({220.0, windowHeight_ - 140.0});
         }
         else if (currentInputField_ == InputField::Value)
         {
-            focusRect.setPosition({340.0, windowHeight_ - 140.0});
+            focusRect_.setPosition({340.0, windowHeight_ - 140.0});
         }
 
-        window_.draw(focusRect);
+        window_.draw(focusRect_);
 
-        // 求解按钮
+        // 求解按钮, 求解过程中变为取消按钮并显示进度
         if (solving_)
         {
-            sf::Text solvingText("Solving...", font_, 25);
-            solvingText.setFillColor(sf::Color::Black);
-            solvingText.setPosition({510.0, windowHeight_ - 140});
-            window_.draw(solvingText);
+            solvingText_.setString("Solving... " + std::to_string(progress_.load(std::memory_order_relaxed)) + " nodes");
+            window_.draw(cancelButton_);
+            window_.draw(cancelText_);
+            window_.draw(solvingText_);
         }
         else
         {
-            sf::Text solveText("Solve", font_, 25);
-            solveText.setFillColor(sf::Color::Black);
-            solveText.setPosition({510.0, windowHeight_ - 140});
             window_.draw(solveButton_);
-            window_.draw(solveText);
+            window_.draw(solveText_);
         }
 
-        // 生成按钮
-        sf::Text generateText("Generate", font_, 20);
-        generateText.setFillColor(sf::Color::White);
-        generateText.setPosition({windowWidth_ - 200.0, 300.0});
-        window_.draw(generateButton_);
-        window_.draw(generateText);
-
         window_.display();
     }
 
@@ -795,114 +905,188 @@ private:
         sf::Event event;
         while (window_.pollEvent(event))
         {
-            if (event.type == sf::Event::Closed)
-                window_.close();
-            else if (event.type == sf::Event::TextEntered)
+            handleEvent(event);
+        }
+    }
+
+    void handleEvent(const sf::Event &event)
+    {
+        // 鼠标移动不改变画面, 其余事件(输入、点击、窗口重新显示等)都重画
+        if (event.type != sf::Event::MouseMoved)
+            dirty_ = true;
+
+        if (event.type == sf::Event::Closed)
+            window_.close();
+        else if (event.type == sf::Event::TextEntered)
+        {
+            if (event.text.unicode < 128 && event.text.unicode != 8) // 8 is backspace
             {
-                if (event.text.unicode < 128 && event.text.unicode != 8) // 8 is backspace
+                if (currentInputField_ == InputField::Row)
                 {
-                    if (currentInputField_ == InputField::Row)
-                    {
-                        currentRowInput_ += static_cast<char>(event.text.unicode);
-                    }
-                    else if (currentInputField_ == InputField::Col)
-                    {
-                        currentColInput_ += static_cast<char>(event.text.unicode);
-                    }
-                    else if (currentInputField_ == InputField::Value)
-                    {
-                        currentValueInput_ += static_cast<char>(event.text.unicode);
-                    }
+                    currentRowInput_ += static_cast<char>(event.text.unicode);
                 }
-                else if (event.text.unicode == 8)
+                else if (currentInputField_ == InputField::Col)
                 {
-                    if (currentInputField_ == InputField::Row && !currentRowInput_.empty())
-                    {
-                        currentRowInput_.pop_back(); // Handle backspace for row input
-                    }
-                    else if (currentInputField_ == InputField::Col && !currentColInput_.empty())
-                    {
-                        currentColInput_.pop_back(); // Handle backspace for col input
-                    }
-                    else if (currentInputField_ == InputField::Value && !currentValueInput_.empty())
-                    {
-                        currentValueInput_.pop_back(); // Handle backspace for value input
-                    }
+                    currentColInput_ += static_cast<char>(event.text.unicode);
+                }
+                else if (currentInputField_ == InputField::Value)
+                {
+                    currentValueInput_ += static_cast<char>(event.text.unicode);
                 }
             }
-            else if (event.type == sf::Event::KeyPressed)
+            else if (event.text.unicode == 8)
             {
-                if (event.key.code == sf::Keyboard::Tab)
+                if (currentInputField_ == InputField::Row && !currentRowInput_.empty())
                 {
-                    // Switch between input fields (Row -> Col -> Value)
-                    switch (currentInputField_)
-                    {
-                    case InputField::Row:
-                        currentInputField_ = InputField::Col;
-                        break;
-                    case InputField::Col:
-                        currentInputField_ = InputField::Value;
-                        break;
-                    case InputField::Value:
-                        currentInputField_ = InputField::Row;
-                        break;
-                    }
+                    currentRowInput_.pop_back(); // Handle backspace for row input
                 }
-                else if (event.key.code == sf::Keyboard::Enter)
+                else if (currentInputField_ == InputField::Col && !currentColInput_.empty())
                 {
-                    // Handle Enter key press to update the Sudoku board
-                    if (!currentRowInput_.empty() && !currentColInput_.empty() && !currentValueInput_.empty())
-                    {
-                        int row = std::stoi(currentRowInput_);
-                        int col = std::stoi(currentColInput_);
-                        int value = std::stoi(currentValueInput_);
-
-                        // Update the Sudoku board with the entered value
-                        if (isValidInput(row, col, value))
-                        {
-                            sudokuBoard_[row - 1][col - 1] = value;
-                        }
-                        else
-                            std::cerr << "请输入合法的行、列、值" << std::endl;
-
-                        // Clear the input fields
-                        currentRowInput_.clear();
-                        currentColInput_.clear();
-                        currentValueInput_.clear();
-                    }
+                    currentColInput_.pop_back(); // Handle backspace for col input
+                }
+                else if (currentInputField_ == InputField::Value && !currentValueInput_.empty())
+                {
+                    currentValueInput_.pop_back(); // Handle backspace for value input
                 }
             }
-            else if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
+        }
+        else if (event.type == sf::Event::KeyPressed)
+        {
+            if (event.key.code == sf::Keyboard::Tab)
             {
-                sf::Vector2i mousePos = sf::Mouse::getPosition(window_);
-
-                // 检查鼠标点击是否在按钮内
-                if (solveButton_.getGlobalBounds().contains({static_cast<float>(mousePos.x), static_cast<float>(mousePos.y)}))
+                // Switch between input fields (Row -> Col -> Value)
+                switch (currentInputField_)
+                {
+                case InputField::Row:
+                    currentInputField_ = InputField::Col;
+                    break;
+                case InputField::Col:
+                    currentInputField_ = InputField::Value;
+                    break;
+                case InputField::Value:
+                    currentInputField_ = InputField::Row;
+                    break;
+                }
+            }
+            else if (event.key.code == sf::Keyboard::Enter)
+            {
+                // Handle Enter key press to update the Sudoku board
+                if (!currentRowInput_.empty() && !currentColInput_.empty() && !currentValueInput_.empty())
                 {
-                    // 触发求解操作
-                    solving_ = true;
+                    int row = std::stoi(currentRowInput_);
+                    int col = std::stoi(currentColInput_);
+                    int value = std::stoi(currentValueInput_);
+
+                    // Update the Sudoku board with the entered value
+                    if (solving_)
+                        std::cerr << "正在求解，请稍候" << std::endl;
+                    else if (isValidInput(row, col, value))
+                    {
+                        bool filled = sudokuBoard_[row - 1][col - 1] == 0 && value != 0;
 
-                    Hanidoku hanidoku;
+                        sudokuBoard_[row - 1][col - 1] = value;
 
-                    // 调用 solve 函数来解决数独
-                    if (hanidoku.solve(sudokuBoard_))
-                        std::cout << "有解" << std::endl;
+                        // 在空格中填数时增量传播, 否则重新载入
+                        if (filled)
+                            updateHints(row - 1, col - 1);
+                        else
+                            updateHints();
+                    }
                     else
-                        std::cout << "无解" << std::endl;
+                        std::cerr << "请输入合法的行、列、值" << std::endl;
 
-                    solving_ = false;
+                    // Clear the input fields
+                    currentRowInput_.clear();
+                    currentColInput_.clear();
+                    currentValueInput_.clear();
                 }
+            }
+        }
+        else if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
+        {
+            sf::Vector2i mousePos = sf::Mouse::getPosition(window_);
 
-                // 检查鼠标点击是否在生成按钮内
-                if (generateButton_.getGlobalBounds().contains({static_cast<float>(mousePos.x), static_cast<float>(mousePos.y)}))
-                {
-                    // 触发生成数独操作
-                    generateSudokuFromFile("D:\\code\\SAT_test\\easy_hanidoku.txt"); // 从文件中生成数独
-                }
+            // 检查鼠标点击是否在按钮内
+            if (solveButton_.getGlobalBounds().contains({static_cast<float>(mousePos.x), static_cast<float>(mousePos.y)}))
+            {
+                // 求解中点击为取消, 否则触发求解操作
+                if (solving_)
+                    cancel_ = true;
+                else
+                    startSolver();
+            }
+
+            // 检查鼠标点击是否在生成按钮内
+            if (!solving_ && generateButton_.getGlobalBounds().contains({static_cast<float>(mousePos.x), static_cast<float>(mousePos.y)}))
+            {
+                // 触发生成数独操作
+                generateSudokuFromFile("D:\\code\\SAT_test\\easy_hanidoku.txt"); // 从文件中生成数独
+                updateHints();
             }
         }
     }
 
+    // 在后台线程求解当前数独板的副本
+    void startSolver()
+    {
+        solving_ = true;
+        cancel_ = false;
+        finished_ = false;
+        progress_ = 0;
+
+        std::vector<std::vector<int>> board = sudokuBoard_;
+
+        worker_ = std::thread([this, board]() mutable
+                              {
+                                  Hanidoku hanidoku;
+                                  hanidoku.SetCancelFlag(&cancel_);
+                                  hanidoku.SetProgressCounter(&progress_);
+
+                                  // 调用 solve 函数来解决数独
+                                  bool flag = hanidoku.solve(board);
+
+                                  {
+                                      std::unique_lock<std::mutex> lock(result_mtx_);
+                                      resultBoard_ = board;
+                                      resultFlag_ = flag;
+                                  }
+
+                                  finished_ = true; });
+    }
+
+    // 每帧检查后台求解是否结束, 结束后把结果写回数独板
+    void pollSolver()
+    {
+        if (!solving_)
+            return;
+
+        // 求解过程中进度一直在变化
+        dirty_ = true;
+
+        if (!finished_)
+            return;
+
+        worker_.join();
+        solving_ = false;
+
+        if (cancel_)
+        {
+            std::cout << "已取消" << std::endl;
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(result_mtx_);
+
+        if (resultFlag_)
+        {
+            sudokuBoard_ = resultBoard_;
+            updateHints();
+            std::cout << "有解" << std::endl;
+        }
+        else
+            std::cout << "无解" << std::endl;
+    }
+
     // 判断输入是否合法
     bool isValidInput(int row, int col, int value)
     {
@@ -0,0 +1,108 @@
+#ifndef MODEL_CHECKER_H
+#define MODEL_CHECKER_H
+
+#include "cnf_parser.h"
+#include "list.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// 求解后检查解是否满足原公式, 防止化简或搜索中的错误给出错误的解
+// 求解前把子句集合复制为连续的文字数组(求解器会修改子句链表), 文字预先转换为真值表的下标
+// 检查时先把未赋值的变元(与公式无关或被化简掉)取为假, 再对文字数组做一遍扫描, 内层循环只有查表与按位或, 没有分支
+class ModelChecker
+{
+public:
+    // 复制子句集合, BoolCount 为原公式的变元数
+    void Snapshot(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        arena.clear();
+        starts.clear();
+        starts.reserve(clauses.size() + 1);
+        this->BoolCount = BoolCount;
+
+        for (auto it_clause = clauses.begin(); it_clause != clauses.end(); ++it_clause)
+        {
+            starts.push_back(arena.size());
+
+            for (auto it_literal = (*it_clause).literals.begin(); it_literal != (*it_clause).literals.end(); ++it_literal)
+            {
+                this->BoolCount = std::max(this->BoolCount, std::abs(*it_literal));
+                arena.push_back(*it_literal);
+            }
+        }
+
+        starts.push_back(arena.size());
+
+        // 文字 l 的真值在 truth[l + BoolCount]
+        for (auto &literal : arena)
+        {
+            literal += this->BoolCount;
+        }
+    }
+
+    bool IsEmpty() const
+    {
+        return starts.empty();
+    }
+
+    // 补全未赋值的变元后检查每个子句, 有子句不满足时输出错误信息并返回false
+    bool Check(std::vector<LiteralStatus> &assignment)
+    {
+        if (assignment.size() < (size_t)BoolCount + 1)
+            assignment.resize(BoolCount + 1, LiteralStatus::Unassigned);
+
+        std::vector<unsigned char> truth(2 * BoolCount + 1, 0);
+
+        for (int var = 1; var <= BoolCount; ++var)
+        {
+            if (assignment[var] == LiteralStatus::Unassigned)
+                assignment[var] = LiteralStatus::False;
+
+            bool value = (assignment[var] == LiteralStatus::True);
+
+            truth[BoolCount + var] = value;
+            truth[BoolCount - var] = !value;
+        }
+
+        const int *literals = arena.data();
+        const unsigned char *table = truth.data();
+        size_t failed = 0;
+        size_t first_failed = 0;
+
+        for (size_t c = 0; c + 1 < starts.size(); ++c)
+        {
+            unsigned char satisfied = 0;
+
+            for (size_t k = starts[c]; k < starts[c + 1]; ++k)
+            {
+                satisfied |= table[literals[k]];
+            }
+
+            if (!satisfied && failed++ == 0)
+                first_failed = c;
+        }
+
+        if (!failed)
+            return true;
+
+        std::cerr << "错误: 求解器给出的解不满足原公式, 共 " << failed << " 个子句不满足, 第一个为第 " << first_failed + 1 << " 个子句:";
+
+        for (size_t k = starts[first_failed]; k < starts[first_failed + 1]; ++k)
+        {
+            std::cerr << " " << literals[k] - BoolCount;
+        }
+
+        std::cerr << " 0" << std::endl;
+
+        return false;
+    }
+
+private:
+    int BoolCount = 0;
+    std::vector<int> arena;         // 所有子句的文字(已转换为真值表下标)
+    std::vector<size_t> starts;     // 每个子句在 arena 中的起点, 最后一项为 arena 的长度
+};
+
+#endif
@@ -0,0 +1,1151 @@
+#ifndef PREPROCESSOR_H
+#define PREPROCESSOR_H
+
+#include "cnf_parser.h"
+#include "list.h"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+// 求解前的预处理器
+// 依次做失败文字试探、等价文字替换、有界变元消去(BVE)以及可选的阻塞/覆盖子句消去(BCE/CCE)
+// 被删除的子句记录在消元栈中, 求解后用于还原完整模型
+// 化简后剩余的变元被重新编号为 1..GetCompactCount(), 以缩小分裂策略需要扫描的范围
+class Preprocessor
+{
+public:
+    Preprocessor() : BoolCount(0), CompactCount(0), unsat(false), occurrence_limit(64), resolvent_limit(24), probe_limit(2000000), probe_ticks(0),
+                     blocked_elimination(false), covered_elimination(false), blocked_limit(5000000), blocked_ticks(0),
+                     eliminated_count(0), failed_count(0), substituted_count(0), blocked_count(0), covered_count(0), original_count(0), simplified_count(0) {}
+
+    // 化简子句集合, BoolCount 被更新为重新编号后的变元数量, 返回false表示推出了空子句(无解)
+    bool Simplify(DeLinkList<cnf_parser::clause> &clauses, int &BoolCount)
+    {
+        Load(clauses, BoolCount);
+
+        if (!unsat && PropagateUnits())
+        {
+            ProbeLiterals();
+
+            if (!unsat)
+                SubstituteEquivalences();
+
+            if (!unsat && PropagateUnits())
+                EliminateVariables();
+
+            if (!unsat && blocked_elimination)
+                EliminateBlockedClauses();
+        }
+
+        Store(clauses);
+
+        BoolCount = this->CompactCount;
+
+        return !unsat;
+    }
+
+    // 把化简后公式的模型(按重新编号后的变元)扩展为原公式的完整模型
+    void ExtendAssignment(std::vector<LiteralStatus> &assignment)
+    {
+        std::vector<LiteralStatus> compact_assignment;
+        compact_assignment.swap(assignment);
+        compact_assignment.resize(CompactCount + 1, LiteralStatus::Unassigned);
+
+        // 顶层赋值直接还原, 化简后公式中未出现的变元可以任意取值
+        assignment.assign(BoolCount + 1, LiteralStatus::False);
+
+        for (int i = 1; i <= BoolCount; ++i)
+        {
+            if (value[i] != LiteralStatus::Unassigned)
+                assignment[i] = value[i];
+            else if (compact[i] != 0 && compact_assignment[compact[i]] == LiteralStatus::True)
+                assignment[i] = LiteralStatus::True;
+        }
+
+        // 逆序处理消元栈, 不满足的子句通过翻转其消元文字来满足
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it)
+        {
+            bool satisfied = false;
+
+            for (const auto literal : it->literals)
+            {
+                if (LiteralValue(assignment, literal) == LiteralStatus::True)
+                {
+                    satisfied = true;
+                    break;
+                }
+            }
+
+            if (!satisfied)
+                assignment[std::abs(it->pivot)] = (it->pivot > 0 ? LiteralStatus::True : LiteralStatus::False);
+        }
+    }
+
+    // 设置消元的限制: 单个文字的最大出现次数以及消解式的最大长度
+    void SetEliminationLimits(int occurrence_limit, int resolvent_limit)
+    {
+        this->occurrence_limit = occurrence_limit;
+        this->resolvent_limit = resolvent_limit;
+    }
+
+    // 设置失败文字试探的工作量上限(访问子句的次数)
+    void SetProbeLimit(long long probe_limit)
+    {
+        this->probe_limit = probe_limit;
+    }
+
+    // 开启阻塞子句消去, covered 为true时同时做覆盖子句消去
+    void SetBlockedClauseElimination(bool blocked, bool covered)
+    {
+        this->blocked_elimination = blocked;
+        this->covered_elimination = blocked && covered;
+    }
+
+    bool IsBlockedClauseElimination() const
+    {
+        return this->blocked_elimination;
+    }
+
+    bool IsCoveredClauseElimination() const
+    {
+        return this->covered_elimination;
+    }
+
+    int GetEliminatedCount() const
+    {
+        return this->eliminated_count;
+    }
+
+    int GetFailedCount() const
+    {
+        return this->failed_count;
+    }
+
+    int GetSubstitutedCount() const
+    {
+        return this->substituted_count;
+    }
+
+    int GetBlockedCount() const
+    {
+        return this->blocked_count;
+    }
+
+    int GetCoveredCount() const
+    {
+        return this->covered_count;
+    }
+
+    int GetCompactCount() const
+    {
+        return this->CompactCount;
+    }
+
+    size_t GetOriginalCount() const
+    {
+        return this->original_count;
+    }
+
+    size_t GetSimplifiedCount() const
+    {
+        return this->simplified_count;
+    }
+
+private:
+    // 消元栈中的一项: 被删除的子句以及还原时需要置真的文字
+    struct EliminatedClause
+    {
+        int pivot;
+        std::vector<int> literals;
+    };
+
+    int BoolCount;
+    int CompactCount;
+    bool unsat;
+    int occurrence_limit;
+    int resolvent_limit;
+    long long probe_limit;
+    long long probe_ticks;
+    bool blocked_elimination;
+    bool covered_elimination;
+    long long blocked_limit;
+    long long blocked_ticks;
+    int eliminated_count;
+    int failed_count;
+    int substituted_count;
+    int blocked_count;
+    int covered_count;
+    size_t original_count;
+    size_t simplified_count;
+    std::vector<std::vector<int>> formula;   // 子句(文字按变元编号排序)
+    std::vector<bool> removed;               // 子句是否已被删除
+    std::vector<std::vector<int>> occurs;    // 文字 -> 含有该文字的子句下标
+    std::vector<LiteralStatus> value;        // 顶层赋值
+    std::vector<bool> eliminated;            // 变元是否已被消去或替换
+    std::vector<LiteralStatus> probe_value;  // 试探传播时的临时赋值
+    std::vector<int> compact;                // 原变元 -> 重新编号后的变元(0表示不再出现)
+    std::vector<int> units;                  // 待传播的单子句
+    std::vector<signed char> mark;           // 求消解式时使用的标记
+    std::vector<EliminatedClause> stack;     // 消元栈
+
+    // 文字在出现表中的下标
+    static int Index(int literal)
+    {
+        return 2 * std::abs(literal) + (literal < 0);
+    }
+
+    // 先按变元编号, 再按正负排序
+    static bool LiteralLess(int a, int b)
+    {
+        return std::abs(a) < std::abs(b) || (std::abs(a) == std::abs(b) && a < b);
+    }
+
+    static LiteralStatus LiteralValue(const std::vector<LiteralStatus> &assignment, int literal)
+    {
+        LiteralStatus status = assignment[std::abs(literal)];
+
+        if (status == LiteralStatus::Unassigned || literal > 0)
+            return status;
+
+        return (status == LiteralStatus::True ? LiteralStatus::False : LiteralStatus::True);
+    }
+
+    // 读入子句集合并初始化各数据结构
+    void Load(DeLinkList<cnf_parser::clause> &clauses, int BoolCount)
+    {
+        this->BoolCount = BoolCount;
+        this->unsat = false;
+        this->eliminated_count = 0;
+        this->failed_count = 0;
+        this->substituted_count = 0;
+        this->blocked_count = 0;
+        this->covered_count = 0;
+        this->probe_ticks = 0;
+        this->blocked_ticks = 0;
+        this->original_count = clauses.size();
+
+        formula.clear();
+        removed.clear();
+        units.clear();
+        stack.clear();
+        occurs.assign(2 * BoolCount + 2, std::vector<int>());
+        value.assign(BoolCount + 1, LiteralStatus::Unassigned);
+        eliminated.assign(BoolCount + 1, false);
+        probe_value.assign(BoolCount + 1, LiteralStatus::Unassigned);
+        compact.assign(BoolCount + 1, 0);
+        mark.assign(BoolCount + 1, 0);
+
+        for (auto it_clause = clauses.begin(); it_clause != clauses.end(); ++it_clause)
+        {
+            std::vector<int> literals;
+
+            for (auto it_literal = (*it_clause).literals.begin(); it_literal != (*it_clause).literals.end(); ++it_literal)
+            {
+                literals.push_back(*it_literal);
+            }
+
+            AddClause(literals);
+        }
+    }
+
+    // 把化简后的公式按重新编号后的变元写回链表, 顶层赋值在还原模型时直接恢复
+    void Store(DeLinkList<cnf_parser::clause> &clauses)
+    {
+        clauses.clear();
+        compact.assign(BoolCount + 1, 0);
+        this->CompactCount = 0;
+
+        if (unsat)
+        {
+            clauses.push_back(cnf_parser::clause());
+            this->simplified_count = 1;
+            return;
+        }
+
+        for (size_t c = 0; c < formula.size(); ++c)
+        {
+            if (removed[c])
+                continue;
+
+            cnf_parser::clause clause;
+
+            for (const auto literal : formula[c])
+            {
+                int var = std::abs(literal);
+
+                if (compact[var] == 0)
+                    compact[var] = ++this->CompactCount;
+
+                clause.literals.push_back(literal > 0 ? compact[var] : -compact[var]);
+            }
+
+            clauses.push_back(clause);
+        }
+
+        this->simplified_count = clauses.size();
+    }
+
+    // 顶层赋值
+    void Assign(int literal)
+    {
+        LiteralStatus status = LiteralValue(value, literal);
+
+        if (status == LiteralStatus::True)
+            return;
+
+        if (status == LiteralStatus::False)
+        {
+            unsat = true;
+            return;
+        }
+
+        value[std::abs(literal)] = (literal > 0 ? LiteralStatus::True : LiteralStatus::False);
+        units.push_back(literal);
+    }
+
+    void RemoveClause(int c)
+    {
+        removed[c] = true;
+    }
+
+    // 返回含有该文字且未被删除的子句
+    std::vector<int> &Occurrences(int literal)
+    {
+        std::vector<int> &list = occurs[Index(literal)];
+
+        list.erase(std::remove_if(list.begin(), list.end(), [this](int c) { return removed[c]; }), list.end());
+
+        return list;
+    }
+
+    // 加入一个子句: 规范化、删除被它包含的子句
+    void AddClause(std::vector<int> literals)
+    {
+        std::sort(literals.begin(), literals.end(), LiteralLess);
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+
+        std::vector<int> normalized;
+
+        for (size_t i = 0; i < literals.size(); ++i)
+        {
+            LiteralStatus status = LiteralValue(value, literals[i]);
+
+            // 子句已被满足或为重言式
+            if (status == LiteralStatus::True)
+                return;
+            if (i > 0 && literals[i] == -literals[i - 1])
+                return;
+
+            if (status == LiteralStatus::Unassigned)
+                normalized.push_back(literals[i]);
+        }
+
+        if (normalized.empty())
+        {
+            unsat = true;
+            return;
+        }
+
+        if (normalized.size() == 1)
+        {
+            Assign(normalized[0]);
+            return;
+        }
+
+        // 反向包含: 删除被新子句包含的子句
+        int best = normalized[0];
+
+        for (const auto literal : normalized)
+        {
+            if (Occurrences(literal).size() < Occurrences(best).size())
+                best = literal;
+        }
+
+        for (const auto c : Occurrences(best))
+        {
+            if (formula[c].size() >= normalized.size() && std::includes(formula[c].begin(), formula[c].end(), normalized.begin(), normalized.end(), LiteralLess))
+                RemoveClause(c);
+        }
+
+        int id = formula.size();
+
+        for (const auto literal : normalized)
+        {
+            occurs[Index(literal)].push_back(id);
+        }
+
+        formula.push_back(normalized);
+        removed.push_back(false);
+    }
+
+    // 单子句传播, 返回false表示产生了空子句
+    bool PropagateUnits()
+    {
+        while (!units.empty() && !unsat)
+        {
+            int unit = units.back();
+            units.pop_back();
+
+            // 含有该文字的子句被满足
+            for (const auto c : Occurrences(unit))
+            {
+                RemoveClause(c);
+            }
+
+            occurs[Index(unit)].clear();
+
+            // 含有其否定的子句删去该文字
+            std::vector<int> list;
+            list.swap(occurs[Index(-unit)]);
+
+            for (const auto c : list)
+            {
+                if (removed[c])
+                    continue;
+
+                std::vector<int> &literals = formula[c];
+                auto it = std::find(literals.begin(), literals.end(), -unit);
+
+                if (it == literals.end())
+                    continue;
+
+                literals.erase(it);
+
+                if (literals.empty())
+                {
+                    unsat = true;
+                }
+                else if (literals.size() == 1)
+                {
+                    RemoveClause(c);
+                    Assign(literals[0]);
+                }
+            }
+        }
+
+        return !unsat;
+    }
+
+    // 是否存在含有该文字的二元子句
+    bool HasBinary(int literal)
+    {
+        for (const auto c : Occurrences(literal))
+        {
+            if (formula[c].size() == 2)
+                return true;
+        }
+
+        return false;
+    }
+
+    // 试探传播: 在临时赋值上做单子句传播, trail 记录被赋值的文字, 返回false表示产生冲突
+    bool ProbePropagate(int literal, std::vector<int> &trail)
+    {
+        trail.clear();
+        trail.push_back(literal);
+        probe_value[std::abs(literal)] = (literal > 0 ? LiteralStatus::True : LiteralStatus::False);
+
+        for (size_t head = 0; head < trail.size(); ++head)
+        {
+            for (const auto c : Occurrences(-trail[head]))
+            {
+                ++probe_ticks;
+
+                int unassigned = 0, last = 0;
+                bool satisfied = false;
+
+                for (const auto other : formula[c])
+                {
+                    LiteralStatus status = LiteralValue(probe_value, other);
+
+                    if (status == LiteralStatus::True)
+                    {
+                        satisfied = true;
+                        break;
+                    }
+
+                    if (status == LiteralStatus::Unassigned)
+                    {
+                        ++unassigned;
+                        last = other;
+                    }
+                }
+
+                if (satisfied)
+                    continue;
+
+                if (unassigned == 0)
+                    return false;
+
+                if (unassigned == 1)
+                {
+                    probe_value[std::abs(last)] = (last > 0 ? LiteralStatus::True : LiteralStatus::False);
+                    trail.push_back(last);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // 撤销试探传播的临时赋值
+    void ResetProbe(const std::vector<int> &trail)
+    {
+        for (const auto literal : trail)
+        {
+            probe_value[std::abs(literal)] = LiteralStatus::Unassigned;
+        }
+    }
+
+    // 失败文字试探: 分别试探变元的两种取值
+    // 某一取值导致冲突则另一取值成为单子句, 两种取值都蕴含的文字同样成为单子句
+    void ProbeLiterals()
+    {
+        std::vector<int> positive, negative, implied;
+
+        for (int var = 1; var <= BoolCount && probe_ticks < probe_limit; ++var)
+        {
+            if (value[var] != LiteralStatus::Unassigned || eliminated[var])
+                continue;
+
+            // 只试探出现在二元子句中的变元
+            if (!HasBinary(var) && !HasBinary(-var))
+                continue;
+
+            bool positive_ok = ProbePropagate(var, positive);
+            ResetProbe(positive);
+
+            if (!positive_ok)
+            {
+                ++failed_count;
+                Assign(-var);
+
+                if (!PropagateUnits())
+                    return;
+
+                continue;
+            }
+
+            bool negative_ok = ProbePropagate(-var, negative);
+
+            if (!negative_ok)
+            {
+                ResetProbe(negative);
+                ++failed_count;
+                Assign(var);
+
+                if (!PropagateUnits())
+                    return;
+
+                continue;
+            }
+
+            implied.clear();
+
+            for (size_t i = 1; i < positive.size(); ++i)
+            {
+                if (LiteralValue(probe_value, positive[i]) == LiteralStatus::True)
+                    implied.push_back(positive[i]);
+            }
+
+            ResetProbe(negative);
+
+            for (const auto literal : implied)
+            {
+                Assign(literal);
+            }
+
+            if (!PropagateUnits())
+                return;
+        }
+    }
+
+    // 用强连通分量求二元蕴含图中的等价文字, 每个分量以变元编号最小的文字为代表进行替换
+    void SubstituteEquivalences()
+    {
+        int nodes = 2 * BoolCount + 2;
+
+        // 二元子句 (a | b) 给出 -a -> b 与 -b -> a
+        std::vector<std::vector<int>> graph(nodes);
+
+        for (size_t c = 0; c < formula.size(); ++c)
+        {
+            if (removed[c] || formula[c].size() != 2)
+                continue;
+
+            int a = formula[c][0], b = formula[c][1];
+            graph[Index(-a)].push_back(Index(b));
+            graph[Index(-b)].push_back(Index(a));
+        }
+
+        // 非递归的 Tarjan 算法
+        std::vector<int> order(nodes, -1), low(nodes, 0), component(nodes, -1);
+        std::vector<int> scc_stack;
+        std::vector<bool> on_stack(nodes, false);
+        std::vector<std::pair<int, size_t>> call;
+        int counter = 0, components = 0;
+
+        for (int root = 2; root < nodes; ++root)
+        {
+            if (order[root] != -1)
+                continue;
+
+            order[root] = low[root] = counter++;
+            scc_stack.push_back(root);
+            on_stack[root] = true;
+            call.push_back({root, 0});
+
+            while (!call.empty())
+            {
+                int node = call.back().first;
+
+                if (call.back().second < graph[node].size())
+                {
+                    int next = graph[node][call.back().second++];
+
+                    if (order[next] == -1)
+                    {
+                        order[next] = low[next] = counter++;
+                        scc_stack.push_back(next);
+                        on_stack[next] = true;
+                        call.push_back({next, 0});
+                    }
+                    else if (on_stack[next])
+                    {
+                        low[node] = std::min(low[node], order[next]);
+                    }
+
+                    continue;
+                }
+
+                if (low[node] == order[node])
+                {
+                    int member;
+
+                    do
+                    {
+                        member = scc_stack.back();
+                        scc_stack.pop_back();
+                        on_stack[member] = false;
+                        component[member] = components;
+                    } while (member != node);
+
+                    ++components;
+                }
+
+                call.pop_back();
+
+                if (!call.empty())
+                    low[call.back().first] = std::min(low[call.back().first], low[node]);
+            }
+        }
+
+        // 按变元编号从小到大确定每个分量的代表文字
+        std::vector<int> representative(components, 0);
+
+        for (int var = 1; var <= BoolCount; ++var)
+        {
+            // 变元与其否定在同一分量中, 公式无解
+            if (component[Index(var)] == component[Index(-var)])
+            {
+                unsat = true;
+                return;
+            }
+
+            if (representative[component[Index(var)]] == 0)
+                representative[component[Index(var)]] = var;
+            if (representative[component[Index(-var)]] == 0)
+                representative[component[Index(-var)]] = -var;
+        }
+
+        for (int var = 1; var <= BoolCount && !unsat; ++var)
+        {
+            if (value[var] != LiteralStatus::Unassigned || eliminated[var])
+                continue;
+
+            int literal = representative[component[Index(var)]];
+
+            if (std::abs(literal) != var)
+                Substitute(var, literal);
+        }
+    }
+
+    // 用等价的文字替换变元 var (var <-> literal)
+    void Substitute(int var, int literal)
+    {
+        // 还原时令 var 取 literal 的值
+        stack.push_back({var, {var, -literal}});
+        stack.push_back({-var, {-var, literal}});
+
+        std::vector<int> targets = Occurrences(var);
+        std::vector<int> &negative = Occurrences(-var);
+        targets.insert(targets.end(), negative.begin(), negative.end());
+
+        for (const auto c : targets)
+        {
+            std::vector<int> literals = formula[c];
+            RemoveClause(c);
+
+            for (auto &other : literals)
+            {
+                if (other == var)
+                    other = literal;
+                else if (other == -var)
+                    other = -literal;
+            }
+
+            AddClause(literals);
+
+            if (unsat)
+                return;
+        }
+
+        eliminated[var] = true;
+        ++substituted_count;
+    }
+
+    // 以 var 为主元求两个子句的消解式, 返回false表示消解式为重言式
+    bool Resolve(const std::vector<int> &a, const std::vector<int> &b, int var, std::vector<int> &resolvent)
+    {
+        bool tautology = false;
+
+        resolvent.clear();
+
+        for (const auto literal : a)
+        {
+            if (std::abs(literal) == var)
+                continue;
+
+            mark[std::abs(literal)] = (literal > 0 ? 1 : -1);
+            resolvent.push_back(literal);
+        }
+
+        for (const auto literal : b)
+        {
+            if (std::abs(literal) == var)
+                continue;
+
+            signed char sign = mark[std::abs(literal)];
+
+            if (sign == 0)
+                resolvent.push_back(literal);
+            else if (sign != (literal > 0 ? 1 : -1))
+            {
+                tautology = true;
+                break;
+            }
+        }
+
+        for (const auto literal : a)
+        {
+            mark[std::abs(literal)] = 0;
+        }
+
+        if (tautology)
+            return false;
+
+        std::sort(resolvent.begin(), resolvent.end(), LiteralLess);
+
+        return true;
+    }
+
+    // 查找与给定文字集合完全相同的子句, 找不到返回-1
+    int FindClause(std::vector<int> literals)
+    {
+        std::sort(literals.begin(), literals.end(), LiteralLess);
+
+        for (const auto c : Occurrences(literals[0]))
+        {
+            if (formula[c] == literals)
+                return c;
+        }
+
+        return -1;
+    }
+
+    // 查找定义 literal 的与门: literal <-> (a1 & ... & ak)
+    // 由二元子句 (-literal | ai) 与长子句 (literal | -a1 | ... | -ak) 组成
+    bool FindAndGate(int literal, std::vector<int> &gate)
+    {
+        std::vector<int> binaries;
+
+        for (const auto c : Occurrences(-literal))
+        {
+            if (formula[c].size() == 2)
+                binaries.push_back(c);
+        }
+
+        if (binaries.empty())
+            return false;
+
+        // 标记被 literal 蕴含的文字
+        for (const auto c : binaries)
+        {
+            int other = (formula[c][0] == -literal ? formula[c][1] : formula[c][0]);
+            mark[std::abs(other)] = (other > 0 ? 1 : -1);
+        }
+
+        int base = -1;
+
+        for (const auto c : Occurrences(literal))
+        {
+            bool match = true;
+
+            for (const auto other : formula[c])
+            {
+                if (other == literal)
+                    continue;
+
+                if (mark[std::abs(other)] != (other > 0 ? -1 : 1))
+                {
+                    match = false;
+                    break;
+                }
+            }
+
+            if (match)
+            {
+                base = c;
+                break;
+            }
+        }
+
+        if (base >= 0)
+        {
+            gate.push_back(base);
+
+            for (const auto other : formula[base])
+            {
+                if (other == literal)
+                    continue;
+
+                // 基子句中每个文字对应的二元子句
+                for (const auto c : binaries)
+                {
+                    if (formula[c][0] == -other || formula[c][1] == -other)
+                    {
+                        gate.push_back(c);
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (const auto c : binaries)
+        {
+            int other = (formula[c][0] == -literal ? formula[c][1] : formula[c][0]);
+            mark[std::abs(other)] = 0;
+        }
+
+        return base >= 0;
+    }
+
+    // 查找定义 literal 的 ITE 门(异或门是其特例): literal <-> (c ? t : e)
+    // 由 (-literal | -c | t), (-literal | c | e), (literal | -c | -t), (literal | c | -e) 组成
+    bool FindIteGate(int literal, std::vector<int> &gate)
+    {
+        std::vector<int> ternaries;
+
+        for (const auto c : Occurrences(-literal))
+        {
+            if (formula[c].size() == 3)
+                ternaries.push_back(c);
+        }
+
+        for (size_t i = 0; i < ternaries.size(); ++i)
+        {
+            for (size_t j = i + 1; j < ternaries.size(); ++j)
+            {
+                std::vector<int> first, second;
+
+                for (const auto other : formula[ternaries[i]])
+                {
+                    if (other != -literal)
+                        first.push_back(other);
+                }
+
+                for (const auto other : formula[ternaries[j]])
+                {
+                    if (other != -literal)
+                        second.push_back(other);
+                }
+
+                // first = (-c, t), second = (c, e)
+                for (int x = 0; x < 2; ++x)
+                {
+                    for (int y = 0; y < 2; ++y)
+                    {
+                        if (first[x] != -second[y])
+                            continue;
+
+                        int not_cond = first[x], then_literal = first[1 - x];
+                        int cond = second[y], else_literal = second[1 - y];
+
+                        int third = FindClause({literal, not_cond, -then_literal});
+                        int fourth = FindClause({literal, cond, -else_literal});
+
+                        if (third >= 0 && fourth >= 0)
+                        {
+                            gate = {ternaries[i], ternaries[j], third, fourth};
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // 门检测: 找到门后只需计算门子句与非门子句之间的消解式
+    bool FindGate(int var, std::vector<int> &gate)
+    {
+        gate.clear();
+
+        if (FindAndGate(var, gate) || FindAndGate(-var, gate))
+            return true;
+
+        gate.clear();
+
+        return FindIteGate(var, gate);
+    }
+
+    // 尝试消去变元: 消解式的数量不超过被删除的子句数量时才执行
+    bool TryEliminate(int var)
+    {
+        std::vector<int> pos = Occurrences(var);
+        std::vector<int> neg = Occurrences(-var);
+        std::vector<int> gate;
+
+        bool has_gate = FindGate(var, gate);
+
+        std::vector<std::vector<int>> resolvents;
+        std::vector<int> resolvent;
+        size_t bound = pos.size() + neg.size();
+
+        for (const auto c_pos : pos)
+        {
+            bool gate_pos = has_gate && std::find(gate.begin(), gate.end(), c_pos) != gate.end();
+
+            for (const auto c_neg : neg)
+            {
+                bool gate_neg = has_gate && std::find(gate.begin(), gate.end(), c_neg) != gate.end();
+
+                // 门子句之间、非门子句之间的消解式是冗余的
+                if (has_gate && gate_pos == gate_neg)
+                    continue;
+
+                if (!Resolve(formula[c_pos], formula[c_neg], var, resolvent))
+                    continue;
+
+                if ((int)resolvent.size() > resolvent_limit)
+                    return false;
+
+                resolvents.push_back(resolvent);
+
+                if (resolvents.size() > bound)
+                    return false;
+            }
+        }
+
+        // 被删除的子句压入消元栈
+        for (const auto c : pos)
+        {
+            stack.push_back({var, formula[c]});
+            RemoveClause(c);
+        }
+
+        for (const auto c : neg)
+        {
+            stack.push_back({-var, formula[c]});
+            RemoveClause(c);
+        }
+
+        eliminated[var] = true;
+        ++eliminated_count;
+
+        for (const auto &literals : resolvents)
+        {
+            AddClause(literals);
+
+            if (unsat)
+                break;
+        }
+
+        return true;
+    }
+
+    // 判断子句是否被阻塞, 开启覆盖子句消去时先用覆盖文字扩展子句
+    // 扩展 C -> C' (依据文字 l) 时压入 {l, C}: 还原时 C 不满足则翻转 l, 最终被 l 阻塞的子句 C' 压入 {l, C'}
+    bool EliminateIfBlocked(int c)
+    {
+        std::vector<int> extended = formula[c];
+        std::vector<EliminatedClause> steps;
+        bool blocked = false;
+        bool changed = true;
+
+        for (const auto literal : extended)
+        {
+            mark[std::abs(literal)] = (literal > 0 ? 1 : -1);
+        }
+
+        while (changed && !blocked && (int)extended.size() <= resolvent_limit)
+        {
+            changed = false;
+
+            for (size_t i = 0; i < extended.size() && !blocked; ++i)
+            {
+                int literal = extended[i];
+                std::vector<int> &candidates = Occurrences(-literal);
+
+                if ((int)candidates.size() > occurrence_limit)
+                    continue;
+
+                // 与扩展后的子句消解不为重言式的子句的公共文字
+                std::vector<int> covered;
+                bool resolvable = false;
+
+                for (const auto d : candidates)
+                {
+                    ++blocked_ticks;
+
+                    bool tautology = false;
+
+                    for (const auto other : formula[d])
+                    {
+                        if (other != -literal && mark[std::abs(other)] == (other > 0 ? -1 : 1))
+                        {
+                            tautology = true;
+                            break;
+                        }
+                    }
+
+                    if (tautology)
+                        continue;
+
+                    if (!resolvable)
+                    {
+                        resolvable = true;
+
+                        if (!covered_elimination)
+                            break;
+
+                        for (const auto other : formula[d])
+                        {
+                            if (other != -literal && mark[std::abs(other)] == 0)
+                                covered.push_back(other);
+                        }
+                    }
+                    else
+                    {
+                        covered.erase(std::remove_if(covered.begin(), covered.end(), [this, d](int other) {
+                            return std::find(formula[d].begin(), formula[d].end(), other) == formula[d].end();
+                        }), covered.end());
+                    }
+
+                    if (covered.empty())
+                        break;
+                }
+
+                if (!resolvable)
+                {
+                    steps.push_back({literal, extended});
+                    blocked = true;
+                }
+                else if (!covered.empty())
+                {
+                    steps.push_back({literal, extended});
+
+                    for (const auto other : covered)
+                    {
+                        mark[std::abs(other)] = (other > 0 ? 1 : -1);
+                        extended.push_back(other);
+                    }
+
+                    changed = true;
+                }
+            }
+        }
+
+        for (const auto literal : extended)
+        {
+            mark[std::abs(literal)] = 0;
+        }
+
+        if (!blocked)
+            return false;
+
+        stack.insert(stack.end(), steps.begin(), steps.end());
+        RemoveClause(c);
+
+        if (steps.size() > 1)
+            ++covered_count;
+        else
+            ++blocked_count;
+
+        return true;
+    }
+
+    // 阻塞子句消去: 反复扫描子句直到没有变化或达到工作量上限
+    void EliminateBlockedClauses()
+    {
+        bool changed = true;
+
+        while (changed && blocked_ticks < blocked_limit)
+        {
+            changed = false;
+
+            for (size_t c = 0; c < formula.size() && blocked_ticks < blocked_limit; ++c)
+            {
+                if (!removed[c] && EliminateIfBlocked(c))
+                    changed = true;
+            }
+        }
+    }
+
+    // 按出现次数乘积从小到大依次尝试消去变元
+    void EliminateVariables()
+    {
+        for (int round = 0; round < 3; ++round)
+        {
+            std::vector<std::pair<long long, int>> candidates;
+
+            for (int var = 1; var <= BoolCount; ++var)
+            {
+                if (value[var] != LiteralStatus::Unassigned || eliminated[var])
+                    continue;
+
+                long long pos = Occurrences(var).size();
+                long long neg = Occurrences(-var).size();
+
+                if (pos + neg == 0 || pos > occurrence_limit || neg > occurrence_limit)
+                    continue;
+
+                candidates.push_back({pos * neg, var});
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+
+            bool changed = false;
+
+            for (const auto &candidate : candidates)
+            {
+                int var = candidate.second;
+
+                if (value[var] != LiteralStatus::Unassigned || eliminated[var])
+                    continue;
+
+                if (TryEliminate(var))
+                    changed = true;
+
+                if (!PropagateUnits())
+                    return;
+            }
+
+            if (!changed)
+                break;
+        }
+    }
+};
+
+#endif
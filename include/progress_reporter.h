@@ -0,0 +1,110 @@
+#ifndef PROGRESS_REPORTER_H
+#define PROGRESS_REPORTER_H
+
+#include "solver_stats.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// 长时间求解时按固定间隔输出一行进度, 便于区分搜索仍在推进还是已经卡住
+// 求解器在每个搜索结点(CDCL 每次冲突)调用 Due(), 每 CheckPeriod 次才读一次时钟, 未开启时只是一次比较
+// 到期后由求解器收集当前状态并调用 Report() 输出: 运行时间、决策与冲突的速率、搜索深度、已赋值文字数、当前子句数与内存峰值
+class ProgressReporter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // interval 为输出间隔(秒), 不大于0时关闭
+    void SetInterval(double interval, std::ostream *out = &std::cout)
+    {
+        this->interval = interval;
+        this->out = out;
+    }
+
+    double GetInterval() const
+    {
+        return this->interval;
+    }
+
+    bool IsEnabled() const
+    {
+        return this->interval > 0 && this->out;
+    }
+
+    // 每次求解开始时调用
+    void Start()
+    {
+        start_time = Clock::now();
+        last_time = start_time;
+        next_report = start_time + Period();
+        last_decisions = 0;
+        last_conflicts = 0;
+        countdown = CheckPeriod;
+    }
+
+    // 是否到了输出时间
+    bool Due()
+    {
+        if (!IsEnabled() || --countdown > 0)
+            return false;
+
+        countdown = CheckPeriod;
+
+        return Clock::now() >= next_report;
+    }
+
+    // 输出一行进度, 速率按距上一行的增量计算, trail 小于0时不输出已赋值文字数
+    void Report(long long decisions, long long conflicts, long long depth, long long trail, long long clauses)
+    {
+        Clock::time_point now = Clock::now();
+        double elapsed = std::chrono::duration<double>(now - start_time).count();
+        double seconds = std::chrono::duration<double>(now - last_time).count();
+
+        if (seconds <= 0)
+            seconds = 1e-9;
+
+        // 先写入字符串流再整行输出, 避免与其他线程的输出交错
+        std::ostringstream line;
+
+        line << std::fixed << std::setprecision(1);
+        line << "c [进度] " << std::setw(8) << elapsed << " s";
+        line << std::setprecision(0);
+        line << " | 决策 " << std::setw(12) << decisions << " (" << std::setw(9) << (decisions - last_decisions) / seconds << "/s)";
+        line << " | 冲突 " << std::setw(12) << conflicts << " (" << std::setw(9) << (conflicts - last_conflicts) / seconds << "/s)";
+        line << " | 深度 " << std::setw(6) << depth;
+
+        if (trail >= 0)
+            line << " | 已赋值 " << std::setw(8) << trail;
+
+        line << " | 子句 " << std::setw(9) << clauses << " | 内存峰值 " << SolverStats::PeakMemoryKB() << " KB";
+
+        *out << line.str() << std::endl;
+
+        last_time = now;
+        last_decisions = decisions;
+        last_conflicts = conflicts;
+
+        // 从当前时刻重新计时, 避免输出本身很慢时连续输出
+        next_report = now + Period();
+    }
+
+private:
+    static const int CheckPeriod = 64;     // 每调用多少次 Due() 读一次时钟
+
+    double interval = 0;
+    std::ostream *out = &std::cout;
+    int countdown = CheckPeriod;
+    Clock::time_point start_time;
+    Clock::time_point last_time;
+    Clock::time_point next_report;
+    long long last_decisions = 0;
+    long long last_conflicts = 0;
+
+    Clock::duration Period() const
+    {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+    }
+};
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SOLVER_STATS_H
+#define SOLVER_STATS_H
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// 一次求解的统计信息, 由求解器在搜索过程中累加(只是整数自增, 开销可以忽略), 可导出为 JSON
+// DPLL 的冲突为出现空子句的叶结点, 重启与学习子句只在 CDCL 中出现
+struct SolverStats
+{
+    bool result = false;
+    bool model_valid = true;        // 有解时解是否通过对原公式的检查
+    int variables = 0;              // 求解前的变元数
+    long long clauses = 0;          // 求解前的子句数
+    long long decisions = 0;
+    long long propagations = 0;     // 单子句传播赋值的文字数
+    long long conflicts = 0;
+    long long restarts = 0;
+    long long learned_clauses = 0;
+    long long max_depth = 0;        // 最大搜索深度(DPLL 的递归深度, CDCL 的决策层)
+    long long leaves = 0;           // DPLL 搜索树的叶结点数
+    long long min_left = -1;        // 叶结点上剩余子句数的最小值, -1 表示没有叶结点
+    double parse_ms = 0;
+    double preprocess_ms = 0;
+    double search_ms = 0;
+    double verify_ms = 0;
+    long long peak_memory_kb = 0;   // 进程的内存峰值
+
+    void Reset()
+    {
+        *this = SolverStats();
+    }
+
+    // 叶结点: left 为剩余的子句数, 为0时找到解
+    void RecordLeaf(long long left)
+    {
+        ++leaves;
+
+        if (left > 0)
+            ++conflicts;
+
+        if (min_left < 0 || left < min_left)
+            min_left = left;
+    }
+
+    // 进程到目前为止的内存峰值(KB)
+    static long long PeakMemoryKB()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return (long long)(counters.PeakWorkingSetSize / 1024);
+
+        return 0;
+#else
+        struct rusage usage;
+
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    // res 文件对应的统计文件名: 把 .res 换成 .json, 没有 .res 后缀时直接追加
+    static std::string JSONFileName(const std::string &res_filename)
+    {
+        const std::string suffix = ".res";
+
+        if (res_filename.size() >= suffix.size() && res_filename.compare(res_filename.size() - suffix.size(), suffix.size(), suffix) == 0)
+            return res_filename.substr(0, res_filename.size() - suffix.size()) + ".json";
+
+        return res_filename + ".json";
+    }
+
+    bool WriteJSON(const std::string &filename) const
+    {
+        std::ofstream outFile(filename);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败,请重新读取" << std::endl;
+            return false;
+        }
+
+        char buffer[1024];
+
+        snprintf(buffer, sizeof(buffer),
+                 "{\n"
+                 "  \"result\": %s,\n"
+                 "  \"model_valid\": %s,\n"
+                 "  \"variables\": %d,\n"
+                 "  \"clauses\": %lld,\n"
+                 "  \"decisions\": %lld,\n"
+                 "  \"propagations\": %lld,\n"
+                 "  \"conflicts\": %lld,\n"
+                 "  \"restarts\": %lld,\n"
+                 "  \"learned_clauses\": %lld,\n"
+                 "  \"max_depth\": %lld,\n"
+                 "  \"leaves\": %lld,\n"
+                 "  \"min_left\": %lld,\n"
+                 "  \"time_ms\": {\"parse\": %.3f, \"preprocess\": %.3f, \"search\": %.3f, \"verify\": %.3f},\n"
+                 "  \"peak_memory_kb\": %lld\n"
+                 "}\n",
+                 result ? "true" : "false", model_valid ? "true" : "false", variables, clauses, decisions, propagations, conflicts, restarts, learned_clauses,
+                 max_depth, leaves, min_left, parse_ms, preprocess_ms, search_ms, verify_ms, peak_memory_kb);
+
+        outFile << buffer;
+
+        return true;
+    }
+};
+
+#endif
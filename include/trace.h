@@ -0,0 +1,213 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 求解过程的纳秒级分阶段计时与 Chrome trace 输出
+// 在热点函数开头声明 TraceScope trace(TracePhase::...); 离开作用域时把耗时累加到对应阶段
+// 只有定义 SAT_TRACE=1 (CMake 选项 ENABLE_TRACE) 时才计时, 否则 TraceScope 是空类, 整个调用在编译期消失
+// 开启 Tracer::EnableEvents 后同时记录每次调用, 可写成 chrome://tracing 或 Perfetto 能打开的 trace-event JSON
+
+#ifndef SAT_TRACE
+#define SAT_TRACE 0
+#endif
+
+constexpr bool TraceEnabled = SAT_TRACE != 0;
+
+enum class TracePhase
+{
+    Parse,
+    Preprocess,
+    Propagate,
+    Analyze,
+    Branch,
+    Count
+};
+
+inline const char *TracePhaseName(TracePhase phase)
+{
+    static const char *names[] = {"parse", "preprocess", "propagate", "analyze", "branch"};
+
+    return names[(int)phase];
+}
+
+class Tracer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Tracer &Instance()
+    {
+        static Tracer tracer;
+
+        return tracer;
+    }
+
+    // 是否记录每次调用(用于 Chrome trace), 最多保存 MaxEvents 个事件
+    void EnableEvents(bool enable)
+    {
+        events_enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    void Reset()
+    {
+        for (int i = 0; i < (int)TracePhase::Count; ++i)
+        {
+            total_ns[i] = 0;
+            calls[i] = 0;
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+        events.clear();
+    }
+
+    void Record(TracePhase phase, Clock::time_point start, Clock::time_point end)
+    {
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+        total_ns[(int)phase].fetch_add(ns, std::memory_order_relaxed);
+        calls[(int)phase].fetch_add(1, std::memory_order_relaxed);
+
+        if (!events_enabled.load(std::memory_order_relaxed))
+            return;
+
+        std::unique_lock<std::mutex> lock(mtx);
+
+        if (events.size() < MaxEvents)
+            events.push_back({phase, std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count(), ns, std::hash<std::thread::id>()(std::this_thread::get_id())});
+    }
+
+    long long GetTotalNs(TracePhase phase) const
+    {
+        return total_ns[(int)phase].load(std::memory_order_relaxed);
+    }
+
+    long long GetCalls(TracePhase phase) const
+    {
+        return calls[(int)phase].load(std::memory_order_relaxed);
+    }
+
+    // 每个阶段一行: 总耗时、调用次数与每次调用的平均耗时, 每行前加 prefix
+    void PrintSummary(std::ostream &out, const std::string &prefix = "") const
+    {
+        for (int i = 0; i < (int)TracePhase::Count; ++i)
+        {
+            long long count = calls[i].load(std::memory_order_relaxed);
+
+            if (!count)
+                continue;
+
+            long long ns = total_ns[i].load(std::memory_order_relaxed);
+            char line[160];
+
+            snprintf(line, sizeof(line), "%-11s %12.3f ms %12lld 次 %10.1f ns/次", TracePhaseName((TracePhase)i), ns / 1e6, count, (double)ns / count);
+            out << prefix << line << '\n';
+        }
+
+        out.flush();
+    }
+
+    // 写出 trace-event JSON, 每个事件为一个完整事件("ph": "X"), 时间单位为微秒
+    bool WriteChromeTrace(const std::string &filename)
+    {
+        std::ofstream outFile(filename);
+
+        if (!outFile)
+        {
+            std::cerr << "文件打开失败,请重新读取" << std::endl;
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mtx);
+
+        // 线程号压缩为小整数便于查看
+        std::vector<size_t> threads;
+
+        outFile << "{\"traceEvents\": [\n";
+
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            const Event &event = events[i];
+            size_t tid = 0;
+
+            while (tid < threads.size() && threads[tid] != event.thread)
+                ++tid;
+
+            if (tid == threads.size())
+                threads.push_back(event.thread);
+
+            char line[160];
+            snprintf(line, sizeof(line), "{\"name\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %zu}%s\n",
+                     TracePhaseName(event.phase), event.start_ns / 1e3, event.duration_ns / 1e3, tid, i + 1 < events.size() ? "," : "");
+            outFile << line;
+        }
+
+        outFile << "]}\n";
+
+        if (events.size() >= MaxEvents)
+            std::cerr << "trace 事件超过 " << MaxEvents << " 个, 之后的事件未记录" << std::endl;
+
+        return true;
+    }
+
+private:
+    struct Event
+    {
+        TracePhase phase;
+        long long start_ns;
+        long long duration_ns;
+        size_t thread;
+    };
+
+    static const size_t MaxEvents = 1000000;
+
+    Clock::time_point origin = Clock::now();
+    std::atomic<long long> total_ns[(int)TracePhase::Count] = {};
+    std::atomic<long long> calls[(int)TracePhase::Count] = {};
+    std::atomic<bool> events_enabled{false};
+    std::mutex mtx;
+    std::vector<Event> events;
+};
+
+// 作用域计时器, Enabled 为 false 时不做任何事
+template <bool Enabled>
+class BasicTraceScope;
+
+template <>
+class BasicTraceScope<true>
+{
+public:
+    explicit BasicTraceScope(TracePhase phase) : phase(phase), start(Tracer::Clock::now()) {}
+
+    ~BasicTraceScope()
+    {
+        Tracer::Instance().Record(phase, start, Tracer::Clock::now());
+    }
+
+    BasicTraceScope(const BasicTraceScope &) = delete;
+    BasicTraceScope &operator=(const BasicTraceScope &) = delete;
+
+private:
+    TracePhase phase;
+    Tracer::Clock::time_point start;
+};
+
+template <>
+class BasicTraceScope<false>
+{
+public:
+    constexpr explicit BasicTraceScope(TracePhase) {}
+};
+
+using TraceScope = BasicTraceScope<TraceEnabled>;
+
+#endif
@@ -1,5 +1,9 @@
 #include "../include/cnf_parser.h"
+#include "../include/cnf_cache.h"
+#include "../include/trace.h"
+#include <cstring>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -8,6 +12,16 @@ int BoolCount, ClauseCount;
 // 读取cnf文件
 bool cnf_parser::ReadCNFFile(const std::string filename, DeLinkList<clause> &clauses)
 {
+    TraceScope trace(TracePhase::Parse);
+
+    loaded_from_cache = binary_cache && CNFCache::Load(filename, clauses, BoolCount, ClauseCount);
+
+    if (loaded_from_cache)
+        return true;
+
+    // clauses 中已有子句时缓存会包含它们, 因此只在从空集合开始读取时写出缓存
+    bool write_cache = binary_cache && clauses.empty();
+
     std::ifstream inFile(filename);
 
     if (!inFile)
@@ -47,6 +61,9 @@ bool cnf_parser::ReadCNFFile(const std::string filename, DeLinkList<clause> &cla
 
     inFile.close();
 
+    if (write_cache)
+        CNFCache::Save(filename, clauses, BoolCount, ClauseCount);
+
     return true;
 }
 
@@ -56,65 +73,156 @@ bool cnf_parser::IsUnitClause(clause clause)
     return (clause.literals.size() == 1);
 }
 
-// 输出res文件
-void cnf_parser::WriteRes(std::vector<LiteralStatus> assignemnt, std::string filename, bool flag, long long runtime, std::vector<size_t> left_nums)
+// res 文件的缓冲输出: 内容先写入 1 MB 的缓冲区, 满了再整块写入文件, 整数手动转换为字符
+class ResBuffer
 {
-    extern int BoolCount;
-    std::ofstream outFile(filename);
+public:
+    explicit ResBuffer(std::ofstream &outFile) : outFile(outFile), buffer(new char[Capacity]), size(0) {}
 
-    if (!outFile)
+    ~ResBuffer()
     {
-        // 处理打开失败的文件
-        std::cerr << "文件打开失败,请重新读取" << std::endl;
-        return;
+        Flush();
     }
 
-    outFile.clear();
-
-    if (!flag)
+    void Append(const char *text, size_t length)
     {
-        outFile << "s 0" << std::endl;
-        outFile << "v" << std::endl;
-        outFile << "t " << runtime << std::endl;
-        outFile << "剩余未满足的子句数量: ";
+        if (size + length > Capacity)
+            Flush();
 
-        for (auto left_num : left_nums)
+        if (length > Capacity)
         {
-            outFile << left_num << " ";
+            outFile.write(text, length);
+            return;
         }
 
-        outFile.close();
-        return;
+        memcpy(buffer.get() + size, text, length);
+        size += length;
     }
 
-    outFile << "s 1" << std::endl;
-    outFile << "v";
+    void Append(const char *text)
+    {
+        Append(text, strlen(text));
+    }
 
-    for (int i = 1; i <= BoolCount; ++i)
+    // 把整数转换为十进制写入 digits, 返回长度
+    static size_t FormatInt(long long value, char digits[])
     {
-        if (assignemnt[i] == LiteralStatus::True)
-        {
-            outFile << " " << i;
-        }
-        else if (assignemnt[i] == LiteralStatus::False)
+        char reversed[24];
+        size_t length = 0;
+        unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+
+        do
         {
-            outFile << " " << -i;
-        }
-        else if (assignemnt[i] == LiteralStatus::Unassigned)
+            reversed[length++] = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+
+        size_t n = 0;
+
+        if (value < 0)
+            digits[n++] = '-';
+
+        while (length)
         {
-            outFile << " " << i << "(Unassigned)";
+            digits[n++] = reversed[--length];
         }
+
+        return n;
+    }
+
+    void AppendInt(long long value)
+    {
+        char digits[24];
+        Append(digits, FormatInt(value, digits));
     }
 
-    outFile << std::endl;
+    void Flush()
+    {
+        if (size)
+            outFile.write(buffer.get(), size);
+
+        size = 0;
+    }
+
+private:
+    static const size_t Capacity = 1 << 20;
+
+    std::ofstream &outFile;
+    std::unique_ptr<char[]> buffer;
+    size_t size;
+};
+
+// 输出res文件
+// 解按每行不超过 ResLineWidth 个字符分为多个 v 行, 未赋值的变元标注 (Unassigned)
+void cnf_parser::WriteRes(const std::vector<LiteralStatus> &assignment, const std::string &filename, bool flag, long long runtime, const std::vector<size_t> &left_nums)
+{
+    extern int BoolCount;
+    std::ofstream outFile(filename);
 
-    outFile << "t " << runtime << std::endl;
-    outFile << "剩余未满足的子句数量: ";
+    if (!outFile)
+    {
+        // 处理打开失败的文件
+        std::cerr << "文件打开失败,请重新读取" << std::endl;
+        return;
+    }
 
-    for (auto left_num : left_nums)
     {
-        outFile << left_num << " ";
+        ResBuffer out(outFile);
+
+        if (!flag)
+        {
+            out.Append("s 0\nv\n");
+        }
+        else
+        {
+            const size_t ResLineWidth = 80;
+            const char unassigned[] = "(Unassigned)";
+            size_t column = 1;
+
+            out.Append("s 1\nv");
+
+            for (int i = 1; i <= BoolCount; ++i)
+            {
+                LiteralStatus status = i < (int)assignment.size() ? assignment[i] : LiteralStatus::Unassigned;
+                char literal[48];
+                size_t length = 0;
+
+                literal[length++] = ' ';
+                length += ResBuffer::FormatInt(status == LiteralStatus::False ? -i : i, literal + length);
+
+                if (status == LiteralStatus::Unassigned)
+                {
+                    memcpy(literal + length, unassigned, sizeof(unassigned) - 1);
+                    length += sizeof(unassigned) - 1;
+                }
+
+                // 换行, 新的一行同样以 v 开头
+                if (column + length > ResLineWidth)
+                {
+                    out.Append("\nv", 2);
+                    column = 1;
+                }
+
+                out.Append(literal, length);
+                column += length;
+            }
+
+            out.Append("\n", 1);
+        }
+
+        out.Append("t ");
+        out.AppendInt(runtime);
+        out.Append("\n剩余未满足的子句数量: ");
+
+        for (auto left_num : left_nums)
+        {
+            out.AppendInt((long long)left_num);
+            out.Append(" ", 1);
+        }
     }
 
     outFile.close();
+
+    if (!outFile)
+        std::cerr << "文件写入失败" << std::endl;
 }
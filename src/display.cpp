@@ -3,8 +3,11 @@
 #include "../include/utils.h"
 #include "../include/list.h"
 #include "../include/hanidoku_solver.h"
+#include "../include/hanidoku_batch.h"
+#include "../include/hanidoku_generator.h"
 #include <iostream>
 #include <functional>
+#include <chrono>
 
 using namespace std;
 
@@ -15,6 +18,10 @@ long long runtime;
 bool result;
 std::vector<LiteralStatus> assignment;
 std::vector<size_t> left_nums;
+double parse_ms;
+
+// 求解 cnf 文件时的进度输出间隔(秒)
+const double ProgressInterval = 5;
 
 void printMenu()
 {
@@ -22,22 +29,44 @@ void printMenu()
     cout << "2、基础SAT求解" << endl;
     cout << "3、优化SAT求解1" << endl;
     cout << "4、优化SAT求解2" << endl;
-    cout << "5、优化SAT求解3" << endl;
+    cout << "5、优化SAT求解3(CDCL)" << endl;
     cout << "6、输出res文件" << endl;
     cout << "7、生成蜂窝数独" << endl;
     cout << "8、求解已有的蜂窝数独" << endl;
     cout << "9、蜂窝数独游戏" << endl;
+    cout << "10、开启/关闭预处理(当前: " << (dpll_solver.IsPreprocessing() ? "开启" : "关闭") << ")" << endl;
+    cout << "11、切换阻塞子句消去(当前: " << (dpll_solver.GetPreprocessor().IsCoveredClauseElimination() ? "BCE+CCE" : (dpll_solver.GetPreprocessor().IsBlockedClauseElimination() ? "BCE" : "关闭")) << ")" << endl;
+    cout << "12、开启/关闭CDCL搜索中的化简(当前: " << (dpll_solver.GetCDCLSolver().IsInprocessing() ? "开启" : "关闭") << ")" << endl;
+    cout << "13、批量求解蜂窝数独" << endl;
+    cout << "14、批量生成蜂窝数独" << endl;
     cout << "0、结束" << endl;
     cout << "请输入你的选择: ";
 }
 
+// 输出预处理的效果
+void printPreprocessInfo()
+{
+    if (!dpll_solver.IsPreprocessing())
+        return;
+
+    const Preprocessor &preprocessor = dpll_solver.GetPreprocessor();
+
+    cout << "预处理: 失败文字 " << preprocessor.GetFailedCount() << " 个, 等价替换 " << preprocessor.GetSubstitutedCount() << " 个, 消去变元 " << preprocessor.GetEliminatedCount() << " 个" << endl;
+    cout << "        阻塞子句 " << preprocessor.GetBlockedCount() << " 个, 覆盖子句 " << preprocessor.GetCoveredCount() << " 个" << endl;
+    cout << "        剩余变元 " << preprocessor.GetCompactCount() << " 个, 子句数 " << preprocessor.GetOriginalCount() << " -> " << preprocessor.GetSimplifiedCount() << endl;
+}
+
 void display(int op)
 {
     extern int BoolCount;
     int count, blank_num, choice;
+    bool read;
     string filename;
     cnf_parser parser;
 
+    // 只在求解 cnf 文件时输出进度, 数独求解不输出
+    dpll_solver.SetProgressInterval(op >= 2 && op <= 5 ? ProgressInterval : 0);
+
     switch (op)
     {
     case 1:
@@ -47,7 +76,11 @@ void display(int op)
             count++;
             cout << "请输入文件路径: ";
             cin >> filename;
-        } while (!parser.ReadCNFFile(filename, clauses) && count < 5);
+
+            auto start_time = std::chrono::high_resolution_clock::now();
+            read = parser.ReadCNFFile(filename, clauses);
+            parse_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start_time).count();
+        } while (!read && count < 5);
 
         if(count == 5) cout << "文件读取失败次数过多，请重新选择操作" << endl;
 
@@ -67,7 +100,9 @@ void display(int op)
         result = result_pair.first;
         runtime = result_pair.second;
 
-        if (result) cout << "有解" << endl;
+        printPreprocessInfo();
+
+        if (result) cout << (dpll_solver.IsModelValid() ? "有解" : "有解, 但解不满足原公式(求解器错误)") << endl;
         else  cout << "无解" << endl;
 
         clauses.clear();
@@ -85,7 +120,9 @@ void display(int op)
         result = result_pair.first;
         runtime = result_pair.second;
 
-        if (result) cout << "有解" << endl;
+        printPreprocessInfo();
+
+        if (result) cout << (dpll_solver.IsModelValid() ? "有解" : "有解, 但解不满足原公式(求解器错误)") << endl;
         else  cout << "无解" << endl;
 
         clauses.clear();
@@ -103,7 +140,9 @@ void display(int op)
         result = result_pair.first;
         runtime = result_pair.second;
 
-        if (result) cout << "有解" << endl;
+        printPreprocessInfo();
+
+        if (result) cout << (dpll_solver.IsModelValid() ? "有解" : "有解, 但解不满足原公式(求解器错误)") << endl;
         else  cout << "无解" << endl;
 
         clauses.clear();
@@ -111,7 +150,24 @@ void display(int op)
         break;
 
     case 5:
-        // cdcl(未完成)
+        if (clauses.empty())
+        {
+            cout << "请先读入cnf文件" << endl;
+            break;
+        }
+
+        result_pair = MeasureTime(std::bind(&DPLLSolver::OptimizedSolve3, &dpll_solver, std::placeholders::_1, std::placeholders::_2), clauses, BoolCount);
+        result = result_pair.first;
+        runtime = result_pair.second;
+
+        printPreprocessInfo();
+
+        cout << "冲突次数: " << dpll_solver.GetCDCLSolver().GetConflicts() << ", 化简轮数: " << dpll_solver.GetCDCLSolver().GetInprocessRounds() << ", 活化删去文字: " << dpll_solver.GetCDCLSolver().GetVivifiedLiterals() << endl;
+
+        if (result) cout << (dpll_solver.IsModelValid() ? "有解" : "有解, 但解不满足原公式(求解器错误)") << endl;
+        else  cout << "无解" << endl;
+
+        clauses.clear();
 
         break;
 
@@ -121,7 +177,16 @@ void display(int op)
         assignment = dpll_solver.GetAssignment();
         left_nums = dpll_solver.GetLeftNums();
         parser.WriteRes(assignment, filename, result, runtime, left_nums);
-        
+
+        // 统计信息写到 res 文件旁边
+        {
+            SolverStats stats = dpll_solver.GetStats();
+            stats.parse_ms = parse_ms;
+
+            if (stats.WriteJSON(SolverStats::JSONFileName(filename)))
+                cout << "统计信息已写入 " << SolverStats::JSONFileName(filename) << endl;
+        }
+
         break;
 
     case 7:
@@ -129,7 +194,14 @@ void display(int op)
             cout << "请输入空格数量：";
             cin >> blank_num;
 
+            cout << "请输入生成的cnf文件路径(输入 0 不输出): ";
+            cin >> filename;
+
             Hanidoku hanidoku;
+
+            if (filename != "0")
+                hanidoku.SetCnfFile(filename);
+
             hanidoku.generate_Hanidoku(blank_num);
 
             cout << endl;
@@ -149,7 +221,11 @@ void display(int op)
             cout << "请输入数独文件路径：";
             cin >> filename;
 
+            cout << "请选择求解方式(1、SAT求解器  2、专用引擎)：";
+            cin >> choice;
+
             Hanidoku hanidoku;
+            hanidoku.SetBackend(choice == 2 ? HanidokuBackend::Native : HanidokuBackend::SAT);
             hanidoku.solve(filename);
 
             cout << endl;
@@ -167,6 +243,76 @@ void display(int op)
 
         break;
 
+    case 10:
+        dpll_solver.SetPreprocessing(!dpll_solver.IsPreprocessing());
+        cout << "预处理已" << (dpll_solver.IsPreprocessing() ? "开启" : "关闭") << endl;
+
+        break;
+
+    case 11:
+        {
+            // 关闭 -> BCE -> BCE+CCE -> 关闭
+            Preprocessor &preprocessor = dpll_solver.GetPreprocessor();
+
+            if (!preprocessor.IsBlockedClauseElimination())
+                preprocessor.SetBlockedClauseElimination(true, false);
+            else if (!preprocessor.IsCoveredClauseElimination())
+                preprocessor.SetBlockedClauseElimination(true, true);
+            else
+                preprocessor.SetBlockedClauseElimination(false, false);
+
+            if (!dpll_solver.IsPreprocessing())
+                cout << "注意: 需要先开启预处理(选项10)" << endl;
+        }
+
+        break;
+
+    case 12:
+        dpll_solver.GetCDCLSolver().SetInprocessing(!dpll_solver.GetCDCLSolver().IsInprocessing());
+        cout << "CDCL搜索中的化简已" << (dpll_solver.GetCDCLSolver().IsInprocessing() ? "开启" : "关闭") << endl;
+
+        break;
+
+    case 13:
+        {
+            string output;
+
+            cout << "请输入数独文件路径：";
+            cin >> filename;
+
+            cout << "请输入结果文件路径：";
+            cin >> output;
+
+            cout << "请选择求解方式(1、SAT求解器  2、专用引擎)：";
+            cin >> choice;
+
+            HanidokuBatch batch;
+            batch.SetBackend(choice == 1 ? HanidokuBackend::SAT : HanidokuBackend::Native);
+            batch.Run(filename, output);
+        }
+
+        break;
+
+    case 14:
+        {
+            long long puzzle_num;
+
+            cout << "请输入生成的题目数量：";
+            cin >> puzzle_num;
+
+            cout << "请输入每题的空格数量：";
+            cin >> blank_num;
+
+            cout << "请输入输出文件路径：";
+            cin >> filename;
+
+            HanidokuGenerator generator;
+            generator.SetBlankCount(blank_num);
+            generator.Run(puzzle_num, filename);
+        }
+
+        break;
+
     default:
         break;
     }
@@ -0,0 +1,389 @@
+#include "../include/dpll_solver.h"
+#include "../include/cnf_parser.h"
+#include "../include/trace.h"
+#include "../include/drat_writer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 无界面的命令行求解程序, 便于脚本批量运行与测量
+// 用法: solver [选项] file.cnf
+// 输出 SAT 竞赛格式: 注释行以 "c " 开头, 结果为 "s SATISFIABLE" / "s UNSATISFIABLE" / "s UNKNOWN", 解为若干 "v" 行并以 0 结尾
+// 退出码: 10 有解, 20 无解, 0 未知(超出限制), 1 参数或文件错误, 2 求解器给出的解不满足原公式
+
+DeLinkList<cnf_parser::clause> clauses;
+DPLLSolver dpll_solver;
+
+enum class Engine
+{
+    Basic,
+    Optimized1,
+    Optimized2,
+    CDCL
+};
+
+struct Options
+{
+    Engine engine = Engine::CDCL;
+    double time_limit = 0;    // 秒, 0 表示不限制
+    long long node_limit = 0; // DPLL 的搜索结点数或 CDCL 的冲突数, 0 表示不限制
+    double progress = 0;      // 进度输出间隔(秒), 0 表示不输出
+    bool preprocessing = false;
+    bool inprocessing = true;
+    bool binary_cache = true; // 是否读写 cnf 文件的二进制缓存
+    bool verify = true;       // 是否检查解满足原公式
+    bool print_model = true;
+    std::string output;       // res 文件路径, 为空时不输出
+    std::string trace;        // Chrome trace 文件路径, 为空时不输出
+    std::string proof;        // DRAT 证明文件路径, 为空时不输出
+    bool proof_binary = true;
+    std::string input;
+};
+
+void printUsage(const char *program)
+{
+    std::cerr << "用法: " << program << " [选项] file.cnf" << std::endl;
+    std::cerr << "  -e, --engine <basic|opt1|opt2|cdcl>  求解算法(默认 cdcl)" << std::endl;
+    std::cerr << "  -t, --time-limit <秒>                超时后输出 s UNKNOWN" << std::endl;
+    std::cerr << "  -n, --node-limit <数量>              搜索结点数(CDCL 为冲突数)上限" << std::endl;
+    std::cerr << "      --progress <秒>                  每隔指定时间输出一行进度(c 行)" << std::endl;
+    std::cerr << "  -p, --preprocess                     开启预处理" << std::endl;
+    std::cerr << "      --no-cache                       不读写二进制缓存 file.cnf.bin" << std::endl;
+    std::cerr << "      --no-inprocess                   关闭 CDCL 搜索中的化简" << std::endl;
+    std::cerr << "  -o, --output <文件>                  同时输出 res 文件与 JSON 统计信息" << std::endl;
+    std::cerr << "      --no-verify                      不检查解是否满足原公式" << std::endl;
+    std::cerr << "  -q, --quiet                          不输出 v 行" << std::endl;
+    std::cerr << "      --proof <文件>                   输出二进制 DRAT 证明(只用于 cdcl, 不能与 -p 同时使用)" << std::endl;
+    std::cerr << "      --proof-text                     以文本格式输出 DRAT 证明" << std::endl;
+    std::cerr << "      --trace <文件>                   输出 Chrome trace(需要以 ENABLE_TRACE 编译)" << std::endl;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+
+        // 需要参数的选项
+        auto value = [&](const char *&result)
+        {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "选项 " << arg << " 缺少参数" << std::endl;
+                return false;
+            }
+
+            result = argv[++i];
+            return true;
+        };
+
+        const char *param = nullptr;
+
+        if (arg == "-e" || arg == "--engine")
+        {
+            if (!value(param))
+                return false;
+
+            if (!strcmp(param, "basic"))
+                options.engine = Engine::Basic;
+            else if (!strcmp(param, "opt1"))
+                options.engine = Engine::Optimized1;
+            else if (!strcmp(param, "opt2"))
+                options.engine = Engine::Optimized2;
+            else if (!strcmp(param, "cdcl") || !strcmp(param, "opt3"))
+                options.engine = Engine::CDCL;
+            else
+            {
+                std::cerr << "未知的求解算法: " << param << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "-t" || arg == "--time-limit")
+        {
+            if (!value(param))
+                return false;
+
+            options.time_limit = atof(param);
+        }
+        else if (arg == "-n" || arg == "--node-limit")
+        {
+            if (!value(param))
+                return false;
+
+            options.node_limit = atoll(param);
+        }
+        else if (arg == "--progress")
+        {
+            if (!value(param))
+                return false;
+
+            options.progress = atof(param);
+        }
+        else if (arg == "-o" || arg == "--output")
+        {
+            if (!value(param))
+                return false;
+
+            options.output = param;
+        }
+        else if (arg == "--proof")
+        {
+            if (!value(param))
+                return false;
+
+            options.proof = param;
+        }
+        else if (arg == "--proof-text")
+            options.proof_binary = false;
+        else if (arg == "--trace")
+        {
+            if (!value(param))
+                return false;
+
+            options.trace = param;
+        }
+        else if (arg == "-p" || arg == "--preprocess")
+            options.preprocessing = true;
+        else if (arg == "--no-cache")
+            options.binary_cache = false;
+        else if (arg == "--no-inprocess")
+            options.inprocessing = false;
+        else if (arg == "--no-verify")
+            options.verify = false;
+        else if (arg == "-q" || arg == "--quiet")
+            options.print_model = false;
+        else if (arg == "-h" || arg == "--help")
+            return false;
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "未知的选项: " << arg << std::endl;
+            return false;
+        }
+        else if (options.input.empty())
+            options.input = arg;
+        else
+        {
+            std::cerr << "只能指定一个 cnf 文件" << std::endl;
+            return false;
+        }
+    }
+
+    if (options.input.empty())
+    {
+        std::cerr << "请指定 cnf 文件" << std::endl;
+        return false;
+    }
+
+    // 证明针对原公式, 只有 CDCL 输出证明, 预处理会改变公式与变元编号
+    if (!options.proof.empty() && (options.engine != Engine::CDCL || options.preprocessing))
+    {
+        std::cerr << "--proof 只能用于 cdcl 且不能开启预处理" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// 按 SAT 竞赛格式输出解, 每行不超过约 80 个字符
+void printModel(const std::vector<LiteralStatus> &assignment, int BoolCount)
+{
+    std::string line = "v";
+
+    for (int i = 1; i <= BoolCount; ++i)
+    {
+        std::string literal = " " + std::to_string(i < (int)assignment.size() && assignment[i] == LiteralStatus::True ? i : -i);
+
+        if (line.size() + literal.size() > 80)
+        {
+            std::cout << line << '\n';
+            line = "v";
+        }
+
+        line += literal;
+    }
+
+    std::cout << line << " 0" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    extern int BoolCount;
+
+    Options options;
+
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    if (!options.trace.empty())
+    {
+        if (TraceEnabled)
+            Tracer::Instance().EnableEvents(true);
+        else
+            std::cerr << "未以 ENABLE_TRACE 编译, 忽略 --trace" << std::endl;
+    }
+
+    cnf_parser parser;
+    parser.SetBinaryCache(options.binary_cache);
+
+    auto parse_start = std::chrono::high_resolution_clock::now();
+
+    if (!parser.ReadCNFFile(options.input, clauses))
+        return 1;
+
+    double parse_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - parse_start).count();
+
+    std::cout << "c 变元数 " << BoolCount << ", 子句数 " << clauses.size() << (parser.IsLoadedFromCache() ? " (读取自二进制缓存)" : "") << std::endl;
+
+    dpll_solver.SetPreprocessing(options.preprocessing);
+    dpll_solver.SetProgressInterval(options.progress);
+    dpll_solver.SetVerifyModel(options.verify);
+    dpll_solver.GetCDCLSolver().SetInprocessing(options.inprocessing);
+
+    // 时间与结点数限制由监视线程检查, 超出后通过取消标志让求解器返回
+    std::atomic<bool> cancel(false);
+    std::atomic<long long> progress(0);
+    std::mutex mtx;
+    std::condition_variable done_cv;
+    bool done = false;
+    std::thread watchdog;
+
+    dpll_solver.SetCancelFlag(&cancel);
+    dpll_solver.SetProgressCounter(&progress);
+
+    DRATWriter proof;
+
+    if (!options.proof.empty())
+    {
+        if (!proof.Open(options.proof, options.proof_binary))
+            return 1;
+
+        dpll_solver.GetCDCLSolver().SetProof(&proof);
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (options.time_limit > 0 || options.node_limit > 0)
+    {
+        watchdog = std::thread([&]()
+                               {
+                                   std::unique_lock<std::mutex> lock(mtx);
+
+                                   while (!done)
+                                   {
+                                       done_cv.wait_for(lock, std::chrono::milliseconds(10));
+
+                                       double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+                                       if ((options.time_limit > 0 && elapsed >= options.time_limit) || (options.node_limit > 0 && progress.load(std::memory_order_relaxed) >= options.node_limit))
+                                       {
+                                           cancel = true;
+                                           break;
+                                       }
+                                   } });
+    }
+
+    bool result = false;
+
+    switch (options.engine)
+    {
+    case Engine::Basic:
+        result = dpll_solver.BasicSolve(clauses, BoolCount);
+        break;
+    case Engine::Optimized1:
+        result = dpll_solver.OptimizedSolve1(clauses, BoolCount);
+        break;
+    case Engine::Optimized2:
+        result = dpll_solver.OptimizedSolve2(clauses, BoolCount);
+        break;
+    case Engine::CDCL:
+        result = dpll_solver.OptimizedSolve3(clauses, BoolCount);
+        break;
+    }
+
+    auto runtime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time).count();
+
+    if (watchdog.joinable())
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done = true;
+        }
+
+        done_cv.notify_all();
+        watchdog.join();
+    }
+
+    // 被取消时求解器返回 false, 但结果未知; 以求解器记录的为准, 搜索结束后监视线程才置位取消标志时结果仍然可信
+    bool unknown = !result && dpll_solver.WasCancelled();
+
+    // 解不满足原公式时不输出结果, 错误信息已由检查输出
+    if (result && !dpll_solver.IsModelValid())
+    {
+        std::cout << "c 错误: 解不满足原公式" << std::endl;
+        std::cout << "s UNKNOWN" << std::endl;
+        return 2;
+    }
+
+    if (proof.IsOpen())
+    {
+        long long proof_bytes = proof.GetBytes();
+
+        dpll_solver.GetCDCLSolver().SetProof(nullptr);
+
+        if (!proof.Close())
+            return 1;
+
+        std::cout << "c 证明 " << proof_bytes << " 字节" << std::endl;
+    }
+
+    std::cout << "c 运行时间 " << runtime << " ms, 搜索结点/冲突 " << progress.load() << std::endl;
+
+    // 各阶段耗时
+    if (TraceEnabled)
+    {
+        Tracer::Instance().PrintSummary(std::cout, "c ");
+
+        if (!options.trace.empty())
+            Tracer::Instance().WriteChromeTrace(options.trace);
+    }
+
+    std::vector<LiteralStatus> assignment = dpll_solver.GetAssignment();
+
+    // res 文件与旁边的 JSON 统计信息
+    if (!options.output.empty() && !unknown)
+    {
+        parser.WriteRes(assignment, options.output, result, runtime, dpll_solver.GetLeftNums());
+
+        SolverStats stats = dpll_solver.GetStats();
+        stats.parse_ms = parse_ms;
+        stats.WriteJSON(SolverStats::JSONFileName(options.output));
+    }
+
+    if (unknown)
+    {
+        std::cout << "s UNKNOWN" << std::endl;
+        return 0;
+    }
+
+    if (!result)
+    {
+        std::cout << "s UNSATISFIABLE" << std::endl;
+        return 20;
+    }
+
+    std::cout << "s SATISFIABLE" << std::endl;
+
+    if (options.print_model)
+        printModel(assignment, BoolCount);
+
+    return 10;
+}